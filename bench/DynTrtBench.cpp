@@ -0,0 +1,393 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Dispatch benchmark suite. Every implementation makes the same Move call on a collection
+// of objects of 2, 4, 16 or 64 implementing types, from L1 to DRAM resident, with the types
+// grouped (sorted) or shuffled, and for non-owning handles with the objects packed together or
+// scattered over the heap. Results are written as JSON, see Harness.h.
+//
+//     DynTrtBench [--out results.json] [--quick] [--filter Trait]
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Any.h"
+#include "Closed.h"
+#include "Dense.h"
+#include "Harness.h"
+
+namespace Bench
+{
+    // Move differs per type so the compiler can't fold the implementations into one.
+    template<std::size_t I>
+    struct Body
+    {
+        inline void Move( double x, double y ) { position += scale * x + double(I + 1) * y; }
+
+        double position = 0.0;
+        double scale = 1.0;
+    };
+
+    struct Shape
+    {
+        template<typename Method, typename T, typename... Ts>
+        static inline Method::return_type Invoke( T*, Ts... );
+
+        struct Move : DynTrt::Method<Move, void(DynTrt::Self, double x, double y)> {
+            template<typename T>
+            static void Invoke( T* self, double x, double y ) { self->Move(x, y); }
+        };
+
+        using Moveable = DynTrt::Trait<Shape, Move>;
+        using InlineMoveable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::InlineLayout>, Move>;
+        using DenseMoveable = DynTrt::DenseTrait<Shape, Move>;
+        using Small = DynTrt::AnySmall<16, Shape, Move>;
+        using Any = DynTrt::Any<Shape, Move>;
+    };
+
+    struct Operations
+    {
+        template<typename T>
+        static void Move( T* self, double x, double y ) { self->Move(x, y); }
+    };
+
+    struct Moveable : DynTrt::Traits<void(void*, double, double)>
+    {
+        template<typename T>
+        Moveable( T* self ) { make_trait<Operations::Move<T>>(self); }
+
+        void Move( double x, double y ) { call<0>(x, y); }
+    };
+
+    struct VirtualShape
+    {
+        virtual ~VirtualShape() = default;
+        virtual void Move( double x, double y )=0;
+    };
+
+    template<std::size_t I>
+    struct VirtualBody : VirtualShape
+    {
+        void Move( double x, double y ) override { body.Move(x, y); }
+
+        Body<I> body;
+    };
+
+    enum class Order
+    {
+        Sorted,     // all objects of a type next to each other
+        Shuffled,
+    };
+
+    inline const char* Name( Order order )
+    {
+        return order == Order::Sorted ? "sorted" : "shuffled";
+    }
+
+    template<typename TySequence>
+    struct Suite;
+
+    template<std::size_t... I>
+    struct Suite<std::index_sequence<I...>>
+    {
+        static constexpr std::size_t types = sizeof...(I);
+
+        using Variant = std::variant<Body<I>...>;
+        using Closed = DynTrt::ClosedTrait<Shape, DynTrt::Types<Body<I>...>, Shape::Move>;
+
+        static void Run( const Options& options, std::span<const std::size_t> counts, std::vector<Result>& results )
+        {
+            for ( std::size_t count : counts )
+            {
+                for ( Order order : { Order::Sorted, Order::Shuffled } )
+                {
+                    const std::vector<std::uint8_t> kinds = Kinds(count, order);
+                    Context context{ options, results, kinds, order };
+
+                    for ( HeapMode mode : { HeapMode::Contiguous, HeapMode::Fragmented } )
+                    {
+                        RunTrait<Shape::Moveable>( context, mode, "Trait" );
+                        RunTrait<Shape::InlineMoveable>( context, mode, "Trait Inline" );
+                        RunTrait<Shape::DenseMoveable>( context, mode, "DenseTrait" );
+                        RunTraits( context, mode );
+                        RunVirtual( context, mode );
+                        RunFunction( context, mode );
+                    }
+
+                    // Owning containers keep the values inline so there is no heap to vary.
+                    RunAny<Shape::Small>( context, "AnySmall" );
+                    RunAny<Shape::Any>( context, "Any" );
+                    RunVariant( context );
+                    RunClosed( context );
+                }
+            }
+        }
+
+    private:
+        struct Context
+        {
+            const Options& options;
+            std::vector<Result>& results;
+            const std::vector<std::uint8_t>& kinds;
+            Order order;
+        };
+
+        // Calls f.template operator()<K>() for the runtime kind.
+        template<typename F>
+        static void WithKind( std::size_t kind, F&& f )
+        {
+            (void)( ( kind == I && (f.template operator()<I>(), true) ) || ... );
+        }
+
+        static std::vector<std::uint8_t> Kinds( std::size_t count, Order order )
+        {
+            std::vector<std::uint8_t> kinds(count);
+            for ( std::size_t i = 0; i < count; i++ )
+                kinds[i] = static_cast<std::uint8_t>(i % types);
+
+            if ( order == Order::Sorted )
+                std::sort( kinds.begin(), kinds.end() );
+            else
+                std::shuffle( kinds.begin(), kinds.end(), std::mt19937{ 7 } );
+
+            return kinds;
+        }
+
+        static bool Skip( const Context& context, const char* name )
+        {
+            return ! context.options.filter.empty() && std::string(name).find(context.options.filter) == std::string::npos;
+        }
+
+        template<typename F>
+        static void Benchmark( Context& context, const char* name, const char* heap, F&& pass )
+        {
+            Result result;
+            result.implementation = name;
+            result.types = types;
+            result.count = context.kinds.size();
+            result.order = Name(context.order);
+            result.heap = heap;
+
+            Measure( result, context.options, context.kinds.size(), pass );
+
+            std::fprintf( stderr, "%-14s types %2zu count %8zu %-8s %-10s %8.3f ns/call\n",
+                name, types, result.count, result.order.c_str(), heap, result.ns_median );
+            context.results.push_back( std::move(result) );
+        }
+
+        // Objects in the heap's allocation order, indexed in iteration order.
+        template<template<std::size_t> typename TyObject>
+        static std::vector<void*> Allocate( Heap& heap, const std::vector<std::uint8_t>& kinds )
+        {
+            std::vector<void*> objects(kinds.size());
+            for ( std::size_t i : heap.AllocationOrder(kinds.size()) )
+                WithKind( kinds[i], [&]<std::size_t K>() { objects[i] = heap.New<TyObject<K>>(); } );
+
+            return objects;
+        }
+
+        // One handle per object, make receives the typed pointer.
+        template<typename TyHandle, template<std::size_t> typename TyObject, typename F>
+        static std::vector<TyHandle> Handles( const Context& context, Heap& heap, F&& make )
+        {
+            const std::vector<void*> objects = Allocate<TyObject>( heap, context.kinds );
+
+            std::vector<TyHandle> handles;
+            handles.reserve( objects.size() );
+            for ( std::size_t i = 0; i < objects.size(); i++ )
+                WithKind( context.kinds[i], [&]<std::size_t K>() { handles.push_back( make(static_cast<TyObject<K>*>(objects[i])) ); } );
+
+            return handles;
+        }
+
+        template<typename TyTrait>
+        static void RunTrait( Context& context, HeapMode mode, const char* name )
+        {
+            if ( Skip(context, name) )
+                return;
+
+            Heap heap{ mode, context.kinds.size() };
+            std::vector<TyTrait> handles = Handles<TyTrait, Body>( context, heap, []( auto* body ) { return TyTrait(body); } );
+            Benchmark( context, name, Name(mode), [&]() {
+                for ( auto& handle : handles )
+                    handle.template Call<Shape::Move>(0.5, 1.0);
+                Escape( handles.data() );
+            });
+        }
+
+        static void RunTraits( Context& context, HeapMode mode )
+        {
+            if ( Skip(context, "Traits") )
+                return;
+
+            Heap heap{ mode, context.kinds.size() };
+            std::vector<Moveable> handles = Handles<Moveable, Body>( context, heap, []( auto* body ) { return Moveable(body); } );
+            Benchmark( context, "Traits", Name(mode), [&]() {
+                for ( auto& handle : handles )
+                    handle.Move(0.5, 1.0);
+                Escape( handles.data() );
+            });
+        }
+
+        static void RunVirtual( Context& context, HeapMode mode )
+        {
+            if ( Skip(context, "virtual") )
+                return;
+
+            Heap heap{ mode, context.kinds.size() };
+            std::vector<VirtualShape*> handles = Handles<VirtualShape*, VirtualBody>( context, heap, []( VirtualShape* shape ) { return shape; } );
+            Benchmark( context, "virtual", Name(mode), [&]() {
+                for ( VirtualShape* handle : handles )
+                    handle->Move(0.5, 1.0);
+                Escape( handles.data() );
+            });
+        }
+
+        static void RunFunction( Context& context, HeapMode mode )
+        {
+            using function = std::function<void(double, double)>;
+            if ( Skip(context, "std::function") )
+                return;
+
+            Heap heap{ mode, context.kinds.size() };
+            std::vector<function> handles = Handles<function, Body>( context, heap, []( auto* body ) { 
+                return function([body]( double x, double y ) { body->Move(x, y); });
+            });
+            Benchmark( context, "std::function", Name(mode), [&]() {
+                for ( auto& handle : handles )
+                    handle(0.5, 1.0);
+                Escape( handles.data() );
+            });
+        }
+
+        template<typename TyAny>
+        static void RunAny( Context& context, const char* name )
+        {
+            if ( Skip(context, name) )
+                return;
+
+            std::vector<TyAny> values;
+            values.reserve( context.kinds.size() );
+            for ( std::uint8_t kind : context.kinds )
+                WithKind( kind, [&]<std::size_t K>() { values.emplace_back( std::in_place_type<Body<K>> ); } );
+
+            Benchmark( context, name, "inline", [&]() {
+                for ( auto& value : values )
+                    value.template Call<Shape::Move>(0.5, 1.0);
+                Escape( values.data() );
+            });
+        }
+
+        static void RunVariant( Context& context )
+        {
+            if ( Skip(context, "std::variant") )
+                return;
+
+            std::vector<Variant> values;
+            values.reserve( context.kinds.size() );
+            for ( std::uint8_t kind : context.kinds )
+                WithKind( kind, [&]<std::size_t K>() { values.emplace_back( std::in_place_type<Body<K>> ); } );
+
+            Benchmark( context, "std::variant", "inline", [&]() {
+                for ( auto& value : values )
+                    std::visit( []( auto& body ) { body.Move(0.5, 1.0); }, value );
+                Escape( values.data() );
+            });
+        }
+
+        static void RunClosed( Context& context )
+        {
+            if ( Skip(context, "ClosedTrait") )
+                return;
+
+            std::vector<Closed> values;
+            values.reserve( context.kinds.size() );
+            for ( std::uint8_t kind : context.kinds )
+                WithKind( kind, [&]<std::size_t K>() { values.emplace_back( Body<K>{} ); } );
+
+            Benchmark( context, "ClosedTrait", "inline", [&]() {
+                for ( auto& value : values )
+                    value.template Call<Shape::Move>(0.5, 1.0);
+                Escape( values.data() );
+            });
+        }
+    };
+
+    template<std::size_t N>
+    using SuiteOf = Suite<std::make_index_sequence<N>>;
+}
+
+int main( int argc, char** argv )
+{
+    using namespace Bench;
+
+    Options options;
+    // Handle plus object is 24 to 40 bytes: roughly L1, L2, L3 and DRAM resident.
+    std::vector<std::size_t> counts = { 1 << 8, 1 << 12, 1 << 16, 1 << 22 };
+    const char* path = nullptr;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( std::strcmp(argv[i], "--out") == 0 && i + 1 < argc )
+            path = argv[++i];
+        else if ( std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc )
+            options.filter = argv[++i];
+        else if ( std::strcmp(argv[i], "--quick") == 0 )
+        {
+            counts = { 1 << 8, 1 << 12 };
+            options.min_time = std::chrono::milliseconds{ 5 };
+        }
+        else
+        {
+            std::fprintf( stderr, "usage: %s [--out results.json] [--quick] [--filter implementation]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    SuiteOf<2>::Run( options, counts, results );
+    SuiteOf<4>::Run( options, counts, results );
+    SuiteOf<16>::Run( options, counts, results );
+    SuiteOf<64>::Run( options, counts, results );
+
+    std::FILE* file = path ? std::fopen(path, "w") : stdout;
+    if ( ! file )
+    {
+        std::fprintf( stderr, "could not open %s\n", path );
+        return 1;
+    }
+
+    WriteJson( file, results );
+
+    if ( path )
+        std::fclose( file );
+
+    return 0;
+}
@@ -0,0 +1,274 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compile time benchmark. Generates a translation unit with one trait of N methods implemented
+// by M types, and compiles it with the compiler the project was configured with. The wall time
+// and peak memory of each compile are written as JSON so build scalability regressions show up
+// when runs from different versions are compared.
+//
+//     DynTrtCompileBench [--out results.json] [--quick] [--repeat 3]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+#include "Harness.h"
+
+namespace Bench
+{
+    struct CompileResult
+    {
+        std::size_t methods = 0;
+        std::size_t types = 0;
+        double seconds = 0.0;
+        std::size_t peak_kb = 0;
+        bool ok = false;
+    };
+
+    // Every type implements every method, so the source grows with methods * types.
+    inline std::string Generate( std::size_t methods, std::size_t types )
+    {
+        std::string source = "#include \"DynTrt.h\"\n\nnamespace Generated\n{\n";
+        source += "struct Shape\n{\n";
+        source += "    template<typename Method, typename T, typename... Ts>\n";
+        source += "    static inline Method::return_type Invoke( T*, Ts... );\n\n";
+        for ( std::size_t i = 0; i < methods; i++ )
+            source += "    struct M" + std::to_string(i) + " : DynTrt::Method<void, int(DynTrt::ConstSelf, int)> {};\n";
+
+        source += "\n    using Wide = DynTrt::Trait<Shape";
+        for ( std::size_t i = 0; i < methods; i++ )
+            source += ", M" + std::to_string(i);
+        source += ">;\n};\n\n";
+
+        for ( std::size_t j = 0; j < types; j++ )
+            source += "struct T" + std::to_string(j) + " { int value = " + std::to_string(j) + "; };\n";
+        source += "\n";
+
+        for ( std::size_t j = 0; j < types; j++ )
+        {
+            for ( std::size_t i = 0; i < methods; i++ )
+            {
+                source += "template<> int Shape::Invoke<Shape::M" + std::to_string(i) + ">( const T" + std::to_string(j) + 
+                    "* self, int x ) { return self->value + x * " + std::to_string(i) + "; }\n";
+            }
+        }
+
+        source += "\nint Sum( const Shape::Wide& shape, int x )\n{\n    int total = 0;\n";
+        for ( std::size_t i = 0; i < methods; i++ )
+            source += "    total += shape.Call<Shape::M" + std::to_string(i) + ">( x );\n";
+        source += "    return total;\n}\n\n";
+
+        source += "int Run()\n{\n    int total = 0;\n";
+        for ( std::size_t j = 0; j < types; j++ )
+        {
+            const std::string name = "t" + std::to_string(j);
+            source += "    T" + std::to_string(j) + " " + name + ";\n";
+            source += "    total += Sum( Shape::Wide{ &" + name + " }, 1 );\n";
+        }
+        source += "    return total;\n}\n}\n";
+        return source;
+    }
+
+    inline std::vector<std::string> CompileCommand( const std::string& source, const std::string& object )
+    {
+        const std::string compiler = DYNTRT_CXX_COMPILER;
+        const std::string include = DYNTRT_INCLUDE_DIR;
+        if ( std::strcmp(DYNTRT_CXX_COMPILER_ID, "MSVC") == 0 )
+            return { compiler, "/nologo", "/std:c++latest", "/c", "/I" + include, "/Fo" + object, source };
+
+        return { compiler, "-std=c++23", "-c", "-I" + include, "-o", object, source };
+    }
+
+    /// Runs command, returns false if it could not be started or failed. peak_kb is the
+    /// largest resident set of the process.
+    inline bool Run( const std::vector<std::string>& command, std::size_t& peak_kb )
+    {
+#if defined(_WIN32)
+        std::string line;
+        for ( const std::string& argument : command )
+            line += "\"" + argument + "\" ";
+
+        STARTUPINFOA startup{};
+        startup.cb = sizeof(startup);
+        PROCESS_INFORMATION process{};
+        if ( ! CreateProcessA( nullptr, line.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process ) )
+            return false;
+
+        WaitForSingleObject( process.hProcess, INFINITE );
+        DWORD code = 1;
+        GetExitCodeProcess( process.hProcess, &code );
+
+        PROCESS_MEMORY_COUNTERS counters{};
+        GetProcessMemoryInfo( process.hProcess, &counters, sizeof(counters) );
+        peak_kb = counters.PeakWorkingSetSize / 1024;
+
+        CloseHandle( process.hThread );
+        CloseHandle( process.hProcess );
+        return code == 0;
+#else
+        std::vector<char*> arguments;
+        for ( const std::string& argument : command )
+            arguments.push_back( const_cast<char*>(argument.c_str()) );
+        arguments.push_back( nullptr );
+
+        pid_t pid;
+        if ( posix_spawnp( &pid, arguments[0], nullptr, nullptr, arguments.data(), environ ) != 0 )
+            return false;
+
+        int status = 0;
+        rusage usage{};
+        if ( wait4( pid, &status, 0, &usage ) != pid )
+            return false;
+
+#if defined(__APPLE__)
+        peak_kb = std::size_t(usage.ru_maxrss) / 1024;
+#else
+        peak_kb = std::size_t(usage.ru_maxrss);
+#endif
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+    }
+
+    /// Best of repeat compiles, by time. Peak memory is the largest seen.
+    inline CompileResult Measure( std::size_t methods, std::size_t types, std::size_t repeat )
+    {
+        const std::string name = std::string(DYNTRT_WORK_DIR) + "/compile_" + std::to_string(methods) + "x" + std::to_string(types);
+        const std::string source = name + ".cpp";
+        const std::string object = name + ".o";
+
+        CompileResult result{ methods, types };
+        std::FILE* file = std::fopen( source.c_str(), "w" );
+        if ( ! file )
+            return result;
+
+        const std::string text = Generate( methods, types );
+        std::fwrite( text.data(), 1, text.size(), file );
+        std::fclose( file );
+
+        result.ok = true;
+        result.seconds = 1e300;
+        for ( std::size_t i = 0; i < repeat && result.ok; i++ )
+        {
+            std::size_t peak_kb = 0;
+            const auto begin = std::chrono::steady_clock::now();
+            result.ok = Run( CompileCommand(source, object), peak_kb );
+            const auto end = std::chrono::steady_clock::now();
+
+            result.seconds = std::min( result.seconds, std::chrono::duration<double>(end - begin).count() );
+            result.peak_kb = std::max( result.peak_kb, peak_kb );
+        }
+
+        std::remove( source.c_str() );
+        std::remove( object.c_str() );
+        return result;
+    }
+
+    inline void WriteJson( std::FILE* file, const std::vector<CompileResult>& results )
+    {
+        std::fprintf( file, "{\n" );
+        std::fprintf( file, "  \"schema\": 1,\n" );
+        std::fprintf( file, "  \"compiler\": \"%s %s\",\n", Escaped(DYNTRT_CXX_COMPILER_ID).c_str(), Escaped(DYNTRT_CXX_COMPILER_VERSION).c_str() );
+        std::fprintf( file, "  \"results\": [\n" );
+        for ( std::size_t i = 0; i < results.size(); i++ )
+        {
+            const CompileResult& result = results[i];
+            std::fprintf( file, 
+                "    { \"methods\": %zu, \"types\": %zu, \"ok\": %s, \"seconds\": %.3f, \"peak_kb\": %zu }%s\n",
+                result.methods, result.types, result.ok ? "true" : "false", result.seconds, result.peak_kb,
+                i + 1 < results.size() ? "," : "" 
+            );
+        }
+        std::fprintf( file, "  ]\n}\n" );
+    }
+}
+
+int main( int argc, char** argv )
+{
+    using namespace Bench;
+
+    std::vector<std::size_t> methods = { 4, 16, 60 };
+    std::vector<std::size_t> types = { 10, 100, 300 };
+    std::size_t repeat = 1;
+    const char* path = nullptr;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( std::strcmp(argv[i], "--out") == 0 && i + 1 < argc )
+            path = argv[++i];
+        else if ( std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc )
+            repeat = std::max( 1, std::atoi(argv[++i]) );
+        else if ( std::strcmp(argv[i], "--quick") == 0 )
+        {
+            methods = { 4, 16 };
+            types = { 10, 50 };
+        }
+        else
+        {
+            std::fprintf( stderr, "usage: %s [--out results.json] [--quick] [--repeat count]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    std::vector<CompileResult> results;
+    for ( std::size_t method_count : methods )
+    {
+        for ( std::size_t type_count : types )
+        {
+            results.push_back( Measure(method_count, type_count, repeat) );
+            const CompileResult& result = results.back();
+            std::fprintf( stderr, "%3zu methods x %3zu types: %s %.2fs %zu KB\n", 
+                method_count, type_count, result.ok ? "ok" : "failed", result.seconds, result.peak_kb );
+        }
+    }
+
+    std::FILE* file = path ? std::fopen(path, "w") : stdout;
+    if ( ! file )
+    {
+        std::fprintf( stderr, "could not open %s\n", path );
+        return 1;
+    }
+
+    WriteJson( file, results );
+
+    if ( path )
+        std::fclose( file );
+
+    bool ok = true;
+    for ( const CompileResult& result : results )
+        ok = ok && result.ok;
+
+    return ok ? 0 : 1;
+}
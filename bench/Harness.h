@@ -0,0 +1,263 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Bench
+{
+    /// Stops the compiler from proving the memory behind pointer is never read.
+    inline void Escape( const void* pointer )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile( "" : : "r"(pointer) : "memory" );
+#else
+        static const void* volatile sink;
+        sink = pointer;
+        _ReadWriteBarrier();
+#endif
+    }
+
+    struct Result
+    {
+        std::string implementation;
+        std::size_t types = 0;
+        std::size_t count = 0;
+        std::string order;
+        std::string heap;
+        double ns_min = 0.0;
+        double ns_median = 0.0;
+        std::size_t passes = 0;
+    };
+
+    struct Options
+    {
+        std::chrono::milliseconds min_time{ 50 };
+        std::size_t min_passes = 5;
+        std::size_t max_passes = 1000;
+        std::string filter;
+    };
+
+    /// Runs pass once to warm up then times it until min_time has elapsed (and at least
+    /// min_passes have run). Each pass makes calls calls, results are per call.
+    template<typename F>
+    inline void Measure( Result& result, const Options& options, std::size_t calls, F&& pass )
+    {
+        using clock = std::chrono::steady_clock;
+
+        pass();
+
+        std::vector<double> samples;
+        const auto start = clock::now();
+        while ( samples.size() < options.min_passes || 
+            ( clock::now() - start < options.min_time && samples.size() < options.max_passes ) )
+        {
+            const auto begin = clock::now();
+            pass();
+            const auto end = clock::now();
+            samples.push_back( std::chrono::duration<double, std::nano>(end - begin).count() / double(calls) );
+        }
+
+        std::sort( samples.begin(), samples.end() );
+        result.ns_min = samples.front();
+        result.ns_median = samples[samples.size() / 2];
+        result.passes = samples.size();
+    }
+
+    enum class HeapMode
+    {
+        Contiguous, // objects bump allocated in iteration order
+        Fragmented, // objects allocated in random order with random gaps between them
+    };
+
+    inline const char* Name( HeapMode mode )
+    {
+        return mode == HeapMode::Contiguous ? "contiguous" : "fragmented";
+    }
+
+    /// Owns the objects pointed to by non-owning handles. Objects are destroyed and memory is
+    /// released when the heap is destroyed.
+    class Heap
+    {
+    public:
+        Heap( HeapMode mode, std::size_t count ): 
+            mode(mode), 
+            arena(mode == HeapMode::Contiguous ? count * 32 + 64 : 64)
+        {}
+
+        Heap( const Heap& )=delete;
+        Heap& operator=( const Heap& )=delete;
+
+        ~Heap()
+        {
+            for ( auto it = destructors.rbegin(); it != destructors.rend(); it++ )
+                it->destroy( it->object );
+            for ( const Allocation& allocation : allocations )
+                std::pmr::new_delete_resource()->deallocate( allocation.pointer, allocation.size, allocation.alignment );
+        }
+
+        template<typename T>
+        T* New()
+        {
+            T* object;
+            if ( mode == HeapMode::Contiguous )
+            {
+                object = new (arena.allocate(sizeof(T), alignof(T))) T{};
+            }
+            else
+            {
+                Allocate( gap(generator), alignof(std::max_align_t) );
+                object = new (Allocate(sizeof(T), alignof(T))) T{};
+            }
+
+            if constexpr ( ! std::is_trivially_destructible_v<T> )
+                destructors.push_back( { object, []( void* object ) { static_cast<T*>(object)->~T(); } } );
+            return object;
+        }
+
+        /// Order objects should be allocated in: iteration order for contiguous heaps, shuffled
+        /// for fragmented ones so neighbouring handles point to unrelated memory.
+        std::vector<std::size_t> AllocationOrder( std::size_t count )
+        {
+            std::vector<std::size_t> order(count);
+            for ( std::size_t i = 0; i < count; i++ )
+                order[i] = i;
+
+            if ( mode == HeapMode::Fragmented )
+                std::shuffle( order.begin(), order.end(), generator );
+
+            return order;
+        }
+
+    private:
+        struct Allocation
+        {
+            void* pointer;
+            std::size_t size;
+            std::size_t alignment;
+        };
+
+        struct Destructor
+        {
+            void* object;
+            void (*destroy)( void* object );
+        };
+
+        void* Allocate( std::size_t size, std::size_t alignment )
+        {
+            void* pointer = std::pmr::new_delete_resource()->allocate( size, alignment );
+            allocations.push_back( { pointer, size, alignment } );
+            return pointer;
+        }
+
+        HeapMode mode;
+        std::pmr::monotonic_buffer_resource arena;
+        std::vector<Allocation> allocations;
+        std::vector<Destructor> destructors;
+        std::mt19937 generator{ 42 };
+        std::uniform_int_distribution<std::size_t> gap{ 8, 128 };
+    };
+
+    inline std::string Escaped( const std::string& text )
+    {
+        std::string escaped;
+        for ( char c : text )
+        {
+            if ( c == '"' || c == '\\' )
+                escaped.push_back('\\');
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+
+    inline const char* Compiler()
+    {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    /// Optimisation the benchmark was compiled with. NDEBUG only says whether asserts are on,
+    /// a -O2 build without it is still optimised. MSVC has no macro for /O, only the debug
+    /// runtime (_DEBUG) shows an unoptimised build.
+    inline const char* Optimisation()
+    {
+#if defined(__OPTIMIZE_SIZE__)
+        return "size";
+#elif defined(__OPTIMIZE__)
+        return "speed";
+#elif defined(__GNUC__)
+        return "none";
+#elif defined(_DEBUG)
+        return "none";
+#else
+        return "unknown";
+#endif
+    }
+
+    /// One object per result so runs from different versions can be diffed or loaded
+    /// straight into a dataframe.
+    inline void WriteJson( std::FILE* file, const std::vector<Result>& results )
+    {
+        std::fprintf( file, "{\n" );
+        std::fprintf( file, "  \"schema\": 2,\n" );
+        std::fprintf( file, "  \"compiler\": \"%s\",\n", Escaped(Compiler()).c_str() );
+        std::fprintf( file, "  \"optimisation\": \"%s\",\n", Optimisation() );
+#if defined(NDEBUG)
+        std::fprintf( file, "  \"asserts\": false,\n" );
+#else
+        std::fprintf( file, "  \"asserts\": true,\n" );
+#endif
+        std::fprintf( file, "  \"results\": [\n" );
+        for ( std::size_t i = 0; i < results.size(); i++ )
+        {
+            const Result& result = results[i];
+            std::fprintf( file, 
+                "    { \"implementation\": \"%s\", \"types\": %zu, \"count\": %zu, \"order\": \"%s\", "
+                "\"heap\": \"%s\", \"ns_per_call_min\": %.4f, \"ns_per_call_median\": %.4f, \"passes\": %zu }%s\n",
+                Escaped(result.implementation).c_str(), result.types, result.count, result.order.c_str(),
+                result.heap.c_str(), result.ns_min, result.ns_median, result.passes,
+                i + 1 < results.size() ? "," : "" 
+            );
+        }
+        std::fprintf( file, "  ]\n}\n" );
+    }
+}
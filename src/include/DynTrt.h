@@ -24,23 +24,30 @@
 #include <concepts>
 #include <type_traits>
 #include <tuple>
+#include <utility>
 #include <any>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
 namespace DynTrt
 {
     namespace detail
     {
+        // Position of the first T in Ts, sizeof...(Ts) if absent. Found by a loop rather than
+        // recursion so the instantiation depth does not grow with the pack.
         template<typename T, typename... Ts>
-        struct index_in_pack;
-
-        template<typename T, typename TyFirst, typename... TyRemaining>
-        struct index_in_pack<T,TyFirst,TyRemaining...> {
-            static constexpr std::size_t value = std::is_same_v<T,TyFirst> ? 0 : 1 + index_in_pack<T, TyRemaining...>::value;
-        };
+        consteval std::size_t find_in_pack()
+        {
+            constexpr bool matches[] = { std::is_same_v<T, Ts>..., false };
+            std::size_t i = 0;
+            while ( i < sizeof...(Ts) && ! matches[i] )
+                i++;
+            return i;
+        }
 
-        template<typename T>
-        struct index_in_pack<T> {
-            static constexpr std::size_t value = 0;
-            static_assert(sizeof(T), "Not found in pack");
+        template<typename T, typename... Ts>
+        struct index_in_pack {
+            static constexpr std::size_t value = find_in_pack<T, Ts...>();
         };
 
         template<typename... Ts>
@@ -67,6 +74,147 @@ namespace DynTrt
         template<typename T>
         using head_t = typename head<T>::type;
 
+        // Flat replacement for std::tuple in vtables. Every entry is a direct base so a table
+        // of N entries is instantiated at constant depth, and brace initialised like a tuple.
+        template<std::size_t I, typename T>
+        struct table_entry
+        {
+            T value;
+        };
+
+        template<typename TyIndices, typename... Ts>
+        struct table_base;
+
+        template<std::size_t... I, typename... Ts>
+        struct table_base<std::index_sequence<I...>, Ts...> : table_entry<I, Ts>... {};
+
+        template<typename... Ts>
+        struct table : table_base<std::index_sequence_for<Ts...>, Ts...> {};
+
+        // Entry I, or the entry of type T (which must appear once), of a table.
+        template<std::size_t I, typename T>
+        constexpr const T& get( const table_entry<I, T>& entry )
+        {
+            return entry.value;
+        }
+
+        template<typename T, std::size_t I>
+        constexpr const T& get( const table_entry<I, T>& entry )
+        {
+            return entry.value;
+        }
+
+        // Type at index I in a pack
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define DYNTRT_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+#if defined(DYNTRT_HAS_TYPE_PACK_ELEMENT)
+        template<std::size_t I, typename... Ts>
+        using type_at_t = __type_pack_element<I, Ts...>;
+#else
+        // Picks the base of a table of identities by overload resolution, so no recursion.
+        template<std::size_t I, typename T>
+        std::type_identity<T> type_at_entry( const table_entry<I, std::type_identity<T>>& );
+
+        template<std::size_t I, typename... Ts>
+        using type_at_t = typename decltype( type_at_entry<I>( std::declval<table<std::type_identity<Ts>...>>() ) )::type;
+#endif
+
+        // Concatenation, only used in unevaluated contexts.
+        template<typename... As, typename... Bs>
+        type_sequence<As..., Bs...> operator+( type_sequence<As...>, type_sequence<Bs...> );
+
+        // The Ts whose bit is set in Mask, in order.
+        template<std::size_t Mask, typename... Ts>
+        struct select
+        {
+            template<std::size_t... I>
+            static auto pick( std::index_sequence<I...> ) -> decltype( 
+                (type_sequence<>{} + ... + std::conditional_t<((Mask >> I) & 1) != 0, type_sequence<Ts>, type_sequence<>>{}) 
+            );
+
+            using type = decltype(pick(std::index_sequence_for<Ts...>{}));
+        };
+
+        template<std::size_t Mask, typename... Ts>
+        using select_t = typename select<Mask, Ts...>::type;
+
+        // The Ts in order of first appearance with duplicates removed, each kept only at the
+        // index where it first appears.
+        template<typename... Ts>
+        struct unique
+        {
+            template<std::size_t... I>
+            static auto pick( std::index_sequence<I...> ) -> decltype(
+                (type_sequence<>{} + ... + std::conditional_t<find_in_pack<Ts, Ts...>() == I, type_sequence<Ts>, type_sequence<>>{})
+            );
+
+            using type = decltype(pick(std::index_sequence_for<Ts...>{}));
+        };
+
+        template<typename TySequence>
+        struct unique_sequence;
+
+        template<typename... Ts>
+        struct unique_sequence<type_sequence<Ts...>>
+        {
+            using type = typename unique<Ts...>::type;
+        };
+
+        // Name of T from the compiler's function signature, no RTTI needed.
+        template<typename T>
+        constexpr std::string_view type_name()
+        {
+#if defined(__clang__) || defined(__GNUC__)
+            constexpr std::string_view signature = __PRETTY_FUNCTION__;
+            constexpr std::size_t begin = signature.find("T = ") + 4;
+            constexpr std::size_t end = signature.find_first_of(";]", begin);
+            return signature.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+            constexpr std::string_view signature = __FUNCSIG__;
+            constexpr std::size_t begin = signature.find("type_name<") + 10;
+            constexpr std::size_t end = signature.rfind(">(void)");
+            std::string_view name = signature.substr(begin, end - begin);
+            for ( std::string_view keyword : { "struct ", "class ", "enum " } )
+            {
+                if ( name.starts_with(keyword) )
+                    name.remove_prefix(keyword.size());
+            }
+            return name;
+#else
+            return "unknown";
+#endif
+        }
+
+        // The address of type_tag<T> is the type's identity. Kept non-const so the linker can
+        // never fold two of them into one object.
+        struct TypeTag
+        {
+            // Small dense index, 0 until something needing one (see Multi.h, Box.h) assigns it.
+            std::atomic<std::uint32_t> index{ 0 };
+        };
+
+        template<typename T>
+        inline TypeTag type_tag{};
+
+        inline std::atomic<std::uint32_t> type_index_count{ 0 };
+
+        // Dense index shared by T and const T, assigned on first use.
+        template<typename T>
+        std::uint32_t type_index()
+        {
+            static const std::uint32_t index = []() {
+                const std::uint32_t assigned = type_index_count.fetch_add(1, std::memory_order_relaxed) + 1;
+                type_tag<T>.index.store( assigned, std::memory_order_release );
+                type_tag<const T>.index.store( assigned, std::memory_order_release );
+                return assigned;
+            }();
+            return index;
+        }
+
         template<typename T>
         struct Signature;
 
@@ -88,17 +236,271 @@ namespace DynTrt
             template<typename Ty>
             using full_arguments = detail::type_sequence<Ty, Args...>;
 
-            template<typename Trait, typename Ty, typename TyMethod>
-            static Ret DummyInvoke()
+            // True if a call with Ts can bind to the parameters of this signature.
+            template<typename... Ts>
+            static constexpr bool callable_with = std::is_invocable_v<Ret(*)(Args...), Ts...>;
+
+            // Entry stored in vtables: takes the type erased self and calls TyMethod's Invk for Ty.
+            // Being typed on void keeps vtables free of function pointer casts, so they can be constexpr.
+            template<typename Trait, typename TyMethod, typename Ty>
+            static Ret Erased( T* self, Args... args )
             {
-                return Trait::template Invoke<TyMethod>((Ty*)nullptr,Args{}...);
+                return TyMethod::template Invk<Trait, TyMethod>(static_cast<const_correct<Ty>*>(self), std::forward<Args>(args)...);
             }
+
+            // Only used unevaluated (see HasOverload) so parameters need not be default constructible.
+            template<typename Trait, typename Ty, typename TyMethod>
+            static auto DummyInvoke() -> decltype( Trait::template Invoke<TyMethod, Ty, Args...>(std::declval<Ty*>(), std::declval<Args>()...) );
         };
     }   
     
+    /// Identity of a type without RTTI: the address of a per-type static, so comparing
+    /// two types is a single pointer compare. Const and non-const types are distinct.
+    using TypeId = const detail::TypeTag*;
+
+    template<typename T>
+    inline constexpr TypeId type_id = &detail::type_tag<T>;
+
+    /// Name identifying T across shared objects and processes. Defaults to the compiler's spelling
+    /// of the type, which only matches between builds by compatible compilers, so specialise it
+    /// for types loaded from plugins (see Plugin.h) or persisted (see Snapshot.h):
+    ///     template<> inline constexpr std::string_view DynTrt::stable_name<acme::Circle> = "acme.Circle";
+    template<typename T>
+    inline constexpr std::string_view stable_name = detail::type_name<T>();
+
+    namespace detail
+    {
+        constexpr std::uint64_t fnv1a( std::string_view text, std::uint64_t hash = 14695981039346656037ull )
+        {
+            for ( char c : text )
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    }
+
+    /// Identity of T that is the same in every shared object and process, a hash of stable_name<T>.
+    template<typename T>
+    inline constexpr std::uint64_t stable_type_id = detail::fnv1a( stable_name<std::remove_cv_t<T>> );
+
+    namespace detail
+    {
+        // Hash of a Traits struct and the name and signature of every method, in order.
+        template<typename TraitsType, typename... TyMethods>
+        inline constexpr std::uint64_t interface_signature = []() {
+            std::uint64_t hash = fnv1a( stable_name<TraitsType> );
+            ( ( hash = fnv1a( type_name<typename TyMethods::template any_pointer<void>>(), fnv1a( stable_name<TyMethods>, hash ) ) ), ... );
+            return hash;
+        }();
+    }
+
+    /// Layout options for Trait and AnyValue.
+    /// TableLayout (default) : the handle stores a pointer to one static vtable per type.
+    /// InlineLayout : the handle stores the function pointers themselves, so a call is a single
+    ///                load. Handles grow by one pointer per method so use for small traits.
+    struct TableLayout {};
+    struct InlineLayout {};
+
+    /// Option giving a trait projection tables, so it converts to any trait with a subset of its
+    /// methods, either of the same Policy or of the Policy without Narrowable such as the plain
+    /// Traits struct (see Trait). Off by default, as each type then costs about 3^N table
+    /// entries for a trait of N methods.
+    struct Narrowable {};
+
+    /// Pass in place of the Traits struct to select options for a trait:
+    ///     using Drawable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::InlineLayout>, Draw, SetColour>;
+    template<typename TraitsType, typename... TyOptions>
+    struct Policy {};
+
+    namespace detail
+    {
+        template<typename T>
+        struct policy
+        {
+            using traits = T;
+            using options = type_sequence<>;
+        };
+
+        template<typename T, typename... TyOptions>
+        struct policy<Policy<T, TyOptions...>>
+        {
+            using traits = T;
+            using options = type_sequence<TyOptions...>;
+        };
+
+        // Traits struct holding the Invoke specialisations, with any Policy removed.
+        template<typename T>
+        using policy_traits_t = typename policy<T>::traits;
+
+        template<typename TyOption, typename TyOptions>
+        inline constexpr bool has_option_in = false;
+
+        template<typename TyOption, typename... TyOptions>
+        inline constexpr bool has_option_in<TyOption, type_sequence<TyOptions...>> = (std::same_as<TyOption, TyOptions> || ...);
+
+        template<typename TyOption, typename T>
+        inline constexpr bool has_option = has_option_in<TyOption, typename policy<T>::options>;
+
+        template<typename T, typename TyOptions>
+        struct make_policy
+        {
+            using type = T;
+        };
+
+        template<typename T, typename TyOption, typename... TyOptions>
+        struct make_policy<T, type_sequence<TyOption, TyOptions...>>
+        {
+            using type = Policy<T, TyOption, TyOptions...>;
+        };
+
+        // T with Narrowable dropped from its options, the plain Traits struct if none are left.
+        template<typename T>
+        struct without_narrowable
+        {
+            using type = T;
+        };
+
+        template<typename T, typename... TyOptions>
+        struct without_narrowable<Policy<T, TyOptions...>>
+        {
+            using options = decltype( 
+                (type_sequence<>{} + ... + std::conditional_t<std::same_as<TyOptions, Narrowable>, type_sequence<>, type_sequence<TyOptions>>{}) 
+            );
+            using type = typename make_policy<T, options>::type;
+        };
+
+        template<typename T>
+        using without_narrowable_t = typename without_narrowable<T>::type;
+
+        // Options that wrap every vtable entry declare thunk_option and provide
+        //     template<typename TyTrait, typename TyMethod, typename T, auto Function> static constexpr auto thunk;
+        // a function with the same signature as Function. See Instrument.h.
+        template<typename T>
+        concept thunk_option = requires { typename T::thunk_option; };
+
+        template<typename TyOptions>
+        struct find_thunk_option
+        {
+            using type = void;
+        };
+
+        template<typename TyOption, typename... TyOptions>
+        struct find_thunk_option<type_sequence<TyOption, TyOptions...>>
+        {
+            using type = std::conditional_t<thunk_option<TyOption>, TyOption, typename find_thunk_option<type_sequence<TyOptions...>>::type>;
+        };
+
+        template<typename T>
+        using thunk_option_t = typename find_thunk_option<typename policy<T>::options>::type;
+
+        // The vtable entry for Function, wrapped by the policy's thunk option if it has one.
+        template<typename TraitsType, typename TyTrait, typename TyMethod, typename T, auto Function>
+        constexpr auto wrap_entry()
+        {
+            using option = thunk_option_t<TraitsType>;
+            if constexpr ( std::is_void_v<option> )
+                return Function;
+            else
+                return option::template thunk<TyTrait, TyMethod, T, Function>;
+        }
+
+        // Method flavours that need to see every mutation of an object declare
+        // static void Mutated( const void* object ), see Memo.h.
+        template<typename T>
+        concept mutation_observer = requires( const void* object ) { T::Mutated(object); };
+
+        template<typename T>
+        struct traits_observers
+        {
+            using type = type_sequence<>;
+        };
+
+        template<typename T>
+        requires requires { typename T::mutation_observers; }
+        struct traits_observers<T>
+        {
+            using type = typename T::mutation_observers;
+        };
+
+        // Observers declared by a Traits struct, see DynTrt::Observers.
+        template<typename TraitsType>
+        using traits_observers_t = typename traits_observers<policy_traits_t<TraitsType>>::type;
+
+        template<typename TyObservers, auto Function, typename = decltype(Function)>
+        struct MutationThunk;
+
+        // Observers are told once the mutator has returned (or thrown), so results computed
+        // while it ran are dropped too.
+        template<typename... TyObservers, auto Function, typename Ret, typename... Args>
+        struct MutationThunk<type_sequence<TyObservers...>, Function, Ret(*)(void*, Args...)>
+        {
+            struct Notify
+            {
+                void* self;
+                ~Notify() { ( TyObservers::Mutated(self), ... ); }
+            };
+
+            static Ret Invk( void* self, Args... args )
+            {
+                Notify notify{ self };
+                return Function(self, std::forward<Args>(args)...);
+            }
+        };
+
+        // Batch entries (see Batch.h) take every object of a run.
+        template<typename... TyObservers, auto Function, typename Ret, typename... Args>
+        struct MutationThunk<type_sequence<TyObservers...>, Function, Ret(*)(void* const*, std::size_t, Args...)>
+        {
+            struct Notify
+            {
+                void* const* objects;
+                std::size_t count;
+                ~Notify()
+                {
+                    for ( std::size_t i = 0; i < count; i++ )
+                        ( TyObservers::Mutated(objects[i]), ... );
+                }
+            };
+
+            static Ret Invk( void* const* objects, std::size_t count, Args... args )
+            {
+                Notify notify{ objects, count };
+                return Function(objects, count, std::forward<Args>(args)...);
+            }
+        };
+
+        // Function, wrapped to notify the observers of TraitsType if TyMethod is non-const. The
+        // observers belong to the Traits struct rather than to a trait, so every vtable of it
+        // (narrowed, dense...) notifies them.
+        template<typename TraitsType, typename TyMethod, auto Function>
+        constexpr auto observe_entry()
+        {
+            using observers = traits_observers_t<TraitsType>;
+            if constexpr ( TyMethod::is_const || std::is_same_v<observers, type_sequence<>> )
+                return Function;
+            else
+                return &MutationThunk<observers, Function>::Invk;
+        }
+    }
+
+    /// Method flavours told of every non-const call made through any vtable of a Traits
+    /// struct, which lists them as
+    ///     using mutation_observers = DynTrt::Observers<CachedBounds>;
+    template<typename... TyObservers>
+    requires( detail::mutation_observer<TyObservers> && ... )
+    using Observers = detail::type_sequence<TyObservers...>;
+
     template<typename TyMethod, typename... TyMethods>
     concept BoundMethod = (std::same_as<TyMethod, TyMethods> || ... );
 
+#ifndef DYNTRT_MAX_PROJECTED_METHODS
+    // Narrowable traits with up to this many methods get projection tables (see Trait).
+    // Each type costs 3^N table entries so keep this small.
+    #define DYNTRT_MAX_PROJECTED_METHODS 6
+#endif
+
     template<typename Traits, typename TyMethod, typename T, typename... Ts>
     concept HasMethod = requires(T value, Ts... args) {
         { Traits::template Invoke<TyMethod>(value, args...) };
@@ -115,9 +517,18 @@ namespace DynTrt
     public:
         struct TypeInfo
         {
-            std::size_t type_hash;
+            TypeId type;
+            // Indexed by a bit mask of TyMethods, the vtable of the trait made of those
+            // methods for the same type, followed by the same for the policy without
+            // Narrowable. Only entry 0, the vtable of this trait for a const pointer to the
+            // type (see ConstTable), exists unless the trait is Narrowable.
+            const void* const* projections;
         };
         using data_pointer = void;
+        using traits_type = detail::policy_traits_t<TraitsType>;
+
+        // InlineLayout stores the vtable in the handle rather than a pointer to it.
+        static constexpr bool is_inline = detail::has_option<InlineLayout, TraitsType>;
 
         template<typename TyMethod, typename T>
         using typed_method_pointer = typename TyMethod::template any_pointer<T>;
@@ -126,7 +537,43 @@ namespace DynTrt
         using method_pointer = typename TyMethod::template any_pointer<data_pointer>;
 
         template<typename T>
-        using vtable = std::tuple<typed_method_pointer<TyMethods,T>...,TypeInfo>; //...
+        using vtable = detail::table<typed_method_pointer<TyMethods,T>...,TypeInfo>;
+
+        // An InlineLayout handle stores the function pointers followed by the static vtable they
+        // were copied from, which the type and projections are read from.
+        using inline_table = detail::table<method_pointer<TyMethods>..., const vtable<void>*>;
+
+        using table_type = std::conditional_t<is_inline, inline_table, const vtable<void>*>;
+
+        static constexpr bool has_projections = 
+            detail::has_option<Narrowable, TraitsType> && sizeof...(TyMethods) <= DYNTRT_MAX_PROJECTED_METHODS;
+
+        // Mask of TyOthers within TyMethods if they appear in the same order, otherwise 0.
+        template<typename... TyOthers>
+        static constexpr std::size_t projection_mask = []() {
+            constexpr std::size_t indices[] = { detail::index_in_pack<TyOthers, TyMethods...>::value... };
+            std::size_t mask = 0;
+            for ( std::size_t i = 0; i < sizeof...(TyOthers); i++ )
+            {
+                if ( indices[i] >= sizeof...(TyMethods) || ( i > 0 && indices[i] <= indices[i - 1] ) )
+                    return std::size_t(0);
+                mask |= std::size_t(1) << indices[i];
+            }
+            return mask;
+        }();
+
+    private:
+        template<typename TyTraits, typename TySequence>
+        struct rebind;
+
+        template<typename TyTraits, typename... TyOthers>
+        struct rebind<TyTraits, detail::type_sequence<TyOthers...>>
+        {
+            using type = Trait<TyTraits, TyOthers...>;
+        };
+
+        template<typename, typename...>
+        friend struct Trait;
         
     public:
         ~Trait()=default;
@@ -138,62 +585,144 @@ namespace DynTrt
 
         template<typename T>
         requires( 
-            (HasOverload<TraitsType, T, TyMethods> && ...)
+            (HasOverload<traits_type, T, TyMethods> && ...)
         )
-        Trait( T* value ): pointer(value)
+        constexpr Trait( T* value ): pointer(value)
         {
-            static vtable<T> static_table = 
-            std::make_tuple(
-                typed_method_pointer<TyMethods,T>(&TyMethods::template Invk<TraitsType, TyMethods>)..., 
-                TypeInfo{typeid(T).hash_code()} 
-            );
-            table = reinterpret_cast<vtable<void>*>(&static_table);
+            SetTable(StaticTable<T, false>());
         }
 
         template<typename T>
         requires( 
-            (HasOverload<TraitsType, T, TyMethods> && ...)
+            (HasOverload<traits_type, T, TyMethods> && ...)
         )
-        Trait( const T* value ): pointer(const_cast<T*>(value))
+        constexpr Trait( const T* value ): pointer(const_cast<T*>(value))
         {
-            static vtable<T> static_table = 
-            std::make_tuple(
-                typed_method_pointer<TyMethods,T>(&TyMethods::template Invk<TraitsType, TyMethods>)..., 
-                TypeInfo{typeid(const T).hash_code()} 
-            );
-            table = reinterpret_cast<vtable<void>*>(&static_table);
+            SetTable(StaticTable<T, true>());
+        }
+
+        /// Narrowing from a Narrowable trait with a superset of our methods (in the same relative order),
+        /// of the same Policy or of one that differs only by Narrowable, so plain aliases can be targets.
+        /// The vtable comes from the source's projections so no type knowledge is needed.
+        ///     Shape::Moveable moveable = transformable;
+        template<typename TySource, typename... TyOthers>
+        requires(
+            ( std::same_as<TySource, TraitsType> || std::same_as<detail::without_narrowable_t<TySource>, TraitsType> ) &&
+            ! std::same_as<Trait, Trait<TySource, TyOthers...>> &&
+            (BoundMethod<TyMethods, TyOthers...> && ...)
+        )
+        Trait( const Trait<TySource, TyOthers...>& other ): pointer(other.pointer)
+        {
+            using other_type = Trait<TySource, TyOthers...>;
+            constexpr std::size_t mask = other_type::template projection_mask<TyMethods...>;
+            static_assert( other_type::has_projections, "Source trait must be Narrowable and within DYNTRT_MAX_PROJECTED_METHODS" );
+            static_assert( mask != 0, "Methods must appear in the same order as in the source trait" );
+
+            constexpr std::size_t offset = std::same_as<TySource, TraitsType> ? 0 : std::size_t(1) << sizeof...(TyOthers);
+            const void* projected = other.Info().projections[offset + mask];
+            SetTable(*static_cast<const vtable<void>*>(projected));
+        }
+
+        /// Handle over pointer using a vtable made by StaticTable for the type pointer points to.
+        /// Lets owning containers that already hold our vtable hand out handles without
+        /// knowing the type, see AnyValue::View.
+        static constexpr Trait FromTable( const vtable<void>& static_table, void* pointer )
+        {
+            Trait trait;
+            trait.pointer = pointer;
+            trait.SetTable(static_table);
+            return trait;
+        }
+
+        template<typename T, bool is_const>
+        static constexpr const vtable<void>& StaticTable()
+        {
+            return static_table<T, is_const>;
+        }
+
+        /// What a handle of this layout stores for static_table, for owners that keep one.
+        static constexpr table_type MakeTable( const vtable<void>& static_table )
+        {
+            if constexpr ( is_inline )
+                return MakeInline(static_table, std::index_sequence_for<TyMethods...>{});
+            else
+                return &static_table;
+        }
+
+        /// The static vtable a stored table was made from.
+        static constexpr const vtable<void>& StaticTableOf( const table_type& table )
+        {
+            if constexpr ( is_inline )
+                return *detail::get<sizeof...(TyMethods)>(table);
+            else
+                return *table;
+        }
+
+        /// The function pointers of a stored table, at the same indices in either layout.
+        static constexpr const auto& Entries( const table_type& table )
+        {
+            if constexpr ( is_inline )
+                return table;
+            else
+                return *table;
+        }
+
+        /// The vtable made by StaticTable<T, true> for the type static_table was made for, so
+        /// owners can hand out handles to a const object without knowing its type.
+        static constexpr const vtable<void>& ConstTable( const vtable<void>& static_table )
+        {
+            return *static_cast<const vtable<void>*>( detail::get<TypeInfo>(static_table).projections[0] );
         }
         
         template<typename TyMethod, typename... Ts>
         requires (
             BoundMethod<TyMethod,TyMethods...> &&
             ! TyMethod::is_const &&
-            std::same_as<typename TyMethod::arguments, detail::type_sequence<Ts...>>
+            TyMethod::template callable_with<Ts...>
         )
-        inline auto Call(Ts... args)
+        inline decltype(auto) Call(Ts&&... args)
         {
             constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
-            return std::get<n>(*table)(pointer, args...);
+            return detail::get<n>(Entries(table))(pointer, std::forward<Ts>(args)...);
         }
 
         template<typename TyMethod, typename... Ts>
         requires (
             TyMethod::is_const &&
             BoundMethod<TyMethod,TyMethods...> &&
-            std::same_as<typename TyMethod::arguments, detail::type_sequence<Ts...>>
+            TyMethod::template callable_with<Ts...>
         )
-        inline auto Call(Ts... args) const
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
+            return detail::get<n>(Entries(table))(pointer, std::forward<Ts>(args)...);
+        }
+
+        // Function pointer stored for TyMethod, lets callers hoist the lookup out of a loop.
+        template<typename TyMethod>
+        requires ( BoundMethod<TyMethod,TyMethods...> )
+        inline method_pointer<TyMethod> Function() const
         {
             constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
-            return std::get<n>(*table)(pointer, args...);
+            return detail::get<n>(Entries(table));
         }
 
+        // Equal for handles to the same concrete type, regardless of layout.
+        constexpr const void* Identity() const
+        {
+            return &StaticTableOf(table);
+        }
+
+        constexpr TypeId Type() const
+        {
+            return Info().type;
+        }
+
+        // Handles made from a const T* only give out const T*.
         template<typename T>
         inline T* Get() 
         {
-            constexpr size_t n = detail::index_in_pack<TypeInfo, TyMethods...>::value;
-            const std::size_t type_hash = std::get<n>(*table ).type_hash;
-            if ( type_hash != typeid(T).hash_code() )
+            if ( Type() != type_id<T> )
                 return nullptr;
 
             return reinterpret_cast<T*>(pointer);
@@ -202,22 +731,142 @@ namespace DynTrt
         template<typename T>
         inline const T* Get() const
         {
-            constexpr size_t n = detail::index_in_pack<TypeInfo, TyMethods...>::value;
-            const std::size_t type_hash = std::get<n>(*table).type_hash;
-            if ( type_hash != typeid(T).hash_code() )
+            const TypeId type = Type();
+            if ( type != type_id<T> && type != type_id<const T> )
                 return nullptr;
 
             return reinterpret_cast<const T*>(pointer);
         }
 
+    private:
+        constexpr Trait()=default;
+
+        template<typename TyMethod, typename T, bool is_const>
+        static constexpr method_pointer<TyMethod> Entry()
+        {
+            constexpr method_pointer<TyMethod> function = &TyMethod::template Erased<traits_type, TyMethod, T>;
+            constexpr method_pointer<TyMethod> wrapped = detail::wrap_entry<TraitsType, Trait, TyMethod, std::conditional_t<is_const, const T, T>, function>();
+            return detail::observe_entry<TraitsType, TyMethod, wrapped>();
+        }
+
+        constexpr const TypeInfo& Info() const
+        {
+            return detail::get<TypeInfo>(StaticTableOf(table));
+        }
+
+        template<std::size_t... I>
+        static constexpr inline_table MakeInline( const vtable<void>& static_table, std::index_sequence<I...> )
+        {
+            return inline_table{ detail::get<I>(static_table)..., &static_table };
+        }
+
+        template<typename T, bool is_const>
+        static constexpr const void* const* Projections()
+        {
+            if constexpr ( has_projections )
+                return MakeProjections<T, is_const>(std::make_index_sequence<std::size_t(2) << sizeof...(TyMethods)>{});
+            else
+                return MakeProjections<T, is_const>(std::index_sequence<0>{});
+        }
+
+        template<typename T, bool is_const, std::size_t... Masks>
+        static constexpr const void* const* MakeProjections( std::index_sequence<Masks...> )
+        {
+            return projections<T, is_const, Masks...>;
+        }
+
+        // The empty mask holds our own const vtable. The full mask is ourselves, handled by
+        // the copy constructor. Indices past the masks are the tables of the plain traits,
+        // shared with handles made directly from a pointer so their Identity matches.
+        template<typename T, bool is_const, std::size_t Index>
+        static constexpr const void* Projection()
+        {
+            constexpr std::size_t count = std::size_t(1) << sizeof...(TyMethods);
+            constexpr std::size_t mask = Index % count;
+            using traits = std::conditional_t<(Index < count), TraitsType, detail::without_narrowable_t<TraitsType>>;
+
+            if constexpr ( Index == 0 )
+                return &static_table<T, true>;
+            else if constexpr ( mask == 0 || ( mask == count - 1 && Index < count ) )
+                return nullptr;
+            else
+            {
+                using projected = typename rebind<traits, detail::select_t<mask, TyMethods...>>::type;
+                return &projected::template StaticTable<T, is_const>();
+            }
+        }
+
+        template<typename T, bool is_const, std::size_t... Masks>
+        static constexpr const void* projections[] = { Projection<T, is_const, Masks>()... };
+
+        // Vtable for T shared by every handle of this trait, constant initialised so making
+        // a handle is only two stores. The projections for every subset of our methods are
+        // created alongside it.
+        template<typename T, bool is_const>
+        static constexpr vtable<void> static_table{
+            Entry<TyMethods, T, is_const>()..., 
+            TypeInfo{ type_id<std::conditional_t<is_const, const T, T>>, Projections<T, is_const>() } 
+        };
+
+        constexpr void SetTable( const vtable<void>& static_table )
+        {
+            table = MakeTable(static_table);
+        }
+
     public:
-        vtable<void>* table = nullptr;
+        table_type table{};
         void* pointer = nullptr;
     };
 
+    namespace detail
+    {
+        template<typename... TyTraits>
+        struct compose;
+
+        template<typename TraitsType, typename... TyMethods, typename... TyTraits>
+        struct compose<Trait<TraitsType, TyMethods...>, TyTraits...>
+        {
+            template<typename T>
+            struct methods;
+
+            template<typename... Ts>
+            struct methods<Trait<TraitsType, Ts...>>
+            {
+                using type = type_sequence<Ts...>;
+            };
+
+            template<typename TySequence>
+            struct rebind;
+
+            template<typename... Ts>
+            struct rebind<type_sequence<Ts...>>
+            {
+                using type = Trait<TraitsType, Ts...>;
+            };
+
+            // methods<> is only defined for traits of the same TraitsType.
+            using merged = decltype( (type_sequence<TyMethods...>{} + ... + typename methods<TyTraits>::type{}) );
+            using type = typename rebind<typename unique_sequence<merged>::type>::type;
+        };
+    }
+
+    /// One trait with the methods of every given trait (of the same Traits struct), in order of
+    /// first appearance with duplicates removed. A composed handle is one pointer and one vtable;
+    /// each component is handed out by narrowing (so the traits must be Narrowable, component
+    /// methods must keep their relative order, and the composed trait must be within
+    /// DYNTRT_MAX_PROJECTED_METHODS).
+    ///     using Entity = DynTrt::Compose<Shape::Drawable, Shape::Moveable>;
+    ///     Shape::Drawable drawable = entity;
+    template<typename... TyTraits>
+    using Compose = typename detail::compose<TyTraits...>::type;
+
     using Self = void*;
     using ConstSelf = const void*;
 
+    /// List of concrete types for closed sets of implementations, see ClosedTrait.
+    template<typename... Ts>
+    using Types = detail::type_sequence<Ts...>;
+
     /// TyDefaultMethod : Method or void. If void no default. If method will try to call Method::Invoke(self,args...) (usually templated)
     /// TyFunction : Function prototype including Self. Usually ReturnType(DynTrt::Self, Type1, Type2... TypeN);
     /// Note: self can be either DynTrt::Self or DynTrt::ConstSelf for const functions.
@@ -231,7 +880,7 @@ namespace DynTrt
         template<typename Trait, typename TyMethod, typename T>
         static inline Ret Invk( T* value, Ts... args )
         {
-            return Trait::template Invoke<TyMethod>(value, args...);
+            return Trait::template Invoke<TyMethod, T, Ts...>(value, std::forward<Ts>(args)...);
         }
     };
 
@@ -245,7 +894,7 @@ namespace DynTrt
         requires( std::derived_from<TyDefaultMethod, Method> )
         static inline Ret Invk( T* value, Ts... args )
         {
-            return TyDefaultMethod::Invoke(value, args...);
+            return TyDefaultMethod::Invoke(value, std::forward<Ts>(args)...);
         }
     };
 
@@ -259,30 +908,29 @@ namespace DynTrt
         template<typename T>
         using vtable = std::tuple<method_pointer<Ts,T>...>;
 
+        template<typename T, auto... methods>
+        static constexpr vtable<T> static_table{ methods... };
+
         template<auto... methods, typename T>
         void make_trait(T* ptr)
         {
-            static vtable<T> vtable_pointer = std::make_tuple(
-                methods...
-            );
-
             pointer = ptr;
-            table = reinterpret_cast<vtable<void>*>(&vtable_pointer);
+            table = reinterpret_cast<const vtable<void>*>(&static_table<T, methods...>);
         }
 
         template<size_t function, typename... TyArgs>
-        auto call( TyArgs... args )
+        decltype(auto) call( TyArgs&&... args )
         {
-            return std::get<function>( *table )( pointer, args... );
+            return std::get<function>( *table )( pointer, std::forward<TyArgs>(args)... );
         }
 
         template<size_t function, typename... TyArgs>
-        auto call( TyArgs... args ) const
+        decltype(auto) call( TyArgs&&... args ) const
         {
-            return std::get<function>( *table )( pointer, args... );
+            return std::get<function>( *table )( pointer, std::forward<TyArgs>(args)... );
         }
 
-        vtable<void>* table;
+        const vtable<void>* table;
         void* pointer; 
     };
 
@@ -23,23 +23,94 @@
 
 #pragma once
 #include <any>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
 #include "DynTrt.h"
 
 namespace DynTrt
 {
+    // Types that can be copied with memcpy and dropped without a destructor call.
     template<typename T>
     concept Anyable = 
         std::is_trivially_copyable_v<T> &&
         std::is_trivially_destructible_v<T>;
 
+    namespace detail
+    {
+        // Lifecycle of a value held in AnyStorage, one static instance per type.
+        // copy/move/destroy are null for Anyable types which are memcpy'd instead.
+        struct StorageOps
+        {
+            TypeId type;
+            std::size_t size;
+            std::size_t alignment;
+            void (*copy)( void* destination, const void* source );
+            void (*move)( void* destination, void* source );
+            void (*destroy)( void* value );
+        };
+
+        template<typename T>
+        inline constexpr StorageOps storage_ops = []() {
+            if constexpr ( Anyable<T> )
+                return StorageOps{ type_id<T>, sizeof(T), alignof(T), nullptr, nullptr, nullptr };
+            else
+                return StorageOps{
+                    type_id<T>, sizeof(T), alignof(T),
+                    []( void* destination, const void* source ) { new (destination) T(*static_cast<const T*>(source)); },
+                    []( void* destination, void* source ) { new (destination) T(std::move(*static_cast<T*>(source))); },
+                    []( void* value ) { static_cast<T*>(value)->~T(); }
+                };
+        }();
+    }
+
     template<std::size_t N = 16>
     struct AnyStorage
     {
         template<typename T>
-        explicit AnyStorage(const T& value): type_hash(typeid(T).hash_code())
+        requires( ! std::same_as<std::remove_cvref_t<T>, AnyStorage> )
+        explicit AnyStorage(T&& value): AnyStorage(std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value)) {}
+
+        template<typename T, typename... Args>
+        explicit AnyStorage(std::in_place_type_t<T>, Args&&... args)
         {
-            static_assert(sizeof(T) <= N,  "Type to big to fit into AnyStorage");
-            memcpy(buffer, &value, sizeof(T));
+            Construct<T>(std::forward<Args>(args)...);
+        }
+
+        AnyStorage( const AnyStorage& other ) { CopyFrom(other); }
+        AnyStorage( AnyStorage&& other ) noexcept { MoveFrom(other); }
+
+        AnyStorage& operator=( const AnyStorage& other )
+        {
+            if ( this != &other )
+            {
+                Destroy();
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        AnyStorage& operator=( AnyStorage&& other ) noexcept
+        {
+            if ( this != &other )
+            {
+                Destroy();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        ~AnyStorage() { Destroy(); }
+
+        /// Destroys the current value and constructs a T in place from args. If that throws
+        /// the storage is left empty.
+        template<typename T, typename... Args>
+        T& emplace(Args&&... args)
+        {
+            Destroy();
+            return Construct<T>(std::forward<Args>(args)...);
         }
 
         template<typename T, bool checked=true>
@@ -49,7 +120,7 @@ namespace DynTrt
 
             if constexpr ( checked )
             {
-                if ( typeid(V).hash_code() != type_hash )
+                if ( ops != &detail::storage_ops<std::remove_const_t<V>> )
                     throw std::bad_any_cast();
             }
 
@@ -58,17 +129,280 @@ namespace DynTrt
             else
                 return (V*)buffer;
         }
+
+        TypeId type() const { return ops->type; }
+
+        void* data() { return buffer; }
+        const void* data() const { return buffer; }
+
+        alignas(std::max_align_t) std::byte buffer[N];
+        // Null only if constructing a value threw.
+        const detail::StorageOps* ops = nullptr;
+
+    private:
+        template<typename T, typename... Args>
+        T& Construct(Args&&... args)
+        {
+            static_assert(sizeof(T) <= N,  "Type to big to fit into AnyStorage");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Type is over aligned for AnyStorage");
+            static_assert(std::is_nothrow_move_constructible_v<T>, "Type must be nothrow move constructible for AnyStorage, use AnyBuffer");
+
+            T* value = new (buffer) T(std::forward<Args>(args)...);
+            ops = &detail::storage_ops<T>;
+
+            // Anyable values are copied as all N bytes, keep the tail defined.
+            if constexpr ( Anyable<T> && sizeof(T) < N )
+                std::memset(buffer + sizeof(T), 0, N - sizeof(T));
+
+            return *value;
+        }
+
+        // ops is only set once the value exists, so a throwing copy leaves us empty.
+        void CopyFrom( const AnyStorage& other )
+        {
+            if ( other.ops && other.ops->copy )
+                other.ops->copy(buffer, other.buffer);
+            else
+                std::memcpy(buffer, other.buffer, N);
+            ops = other.ops;
+        }
+
+        void MoveFrom( AnyStorage& other )
+        {
+            if ( other.ops && other.ops->move )
+                other.ops->move(buffer, other.buffer);
+            else
+                std::memcpy(buffer, other.buffer, N);
+            ops = other.ops;
+        }
+
+        void Destroy()
+        {
+            if ( ops && ops->destroy )
+                ops->destroy(buffer);
+            ops = nullptr;
+        }
+    };
+
+    /// Storage with N bytes inline that spills larger (or throwing-move) types to a
+    /// std::pmr::memory_resource instead of operator new. The resource is carried along
+    /// on copy and move, so values made from an arena keep allocating from it.
+    ///     std::pmr::monotonic_buffer_resource arena;
+    ///     Shape::Any shape{ std::allocator_arg, &arena, Polygon{} };
+    template<std::size_t N = 16>
+    struct AnyBuffer
+    {
+        template<typename T>
+        static constexpr bool fits_inline = 
+            sizeof(T) <= N &&
+            alignof(T) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<T>;
+
+        template<typename T>
+        requires( ! std::same_as<std::remove_cvref_t<T>, AnyBuffer> )
+        explicit AnyBuffer(T&& value): AnyBuffer(std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value)) {}
+
+        template<typename T, typename... Args>
+        explicit AnyBuffer(std::in_place_type_t<T>, Args&&... args): 
+            AnyBuffer(std::allocator_arg, std::pmr::get_default_resource(), std::in_place_type<T>, std::forward<Args>(args)...) 
+        {}
+
+        template<typename T, typename... Args>
+        explicit AnyBuffer(std::allocator_arg_t, std::pmr::memory_resource* resource, std::in_place_type_t<T>, Args&&... args):
+            resource(resource)
+        {
+            Construct<T>(std::forward<Args>(args)...);
+        }
+
+        AnyBuffer( const AnyBuffer& other ): resource(other.resource) { CopyFrom(other); }
+        AnyBuffer( AnyBuffer&& other ) noexcept: resource(other.resource) { MoveFrom(other); }
+
+        AnyBuffer& operator=( const AnyBuffer& other )
+        {
+            if ( this != &other )
+            {
+                Destroy();
+                resource = other.resource;
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        AnyBuffer& operator=( AnyBuffer&& other ) noexcept
+        {
+            if ( this != &other )
+            {
+                Destroy();
+                resource = other.resource;
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        ~AnyBuffer() { Destroy(); }
+
+        template<typename T, typename... Args>
+        T& emplace(Args&&... args)
+        {
+            Destroy();
+            return Construct<T>(std::forward<Args>(args)...);
+        }
+
+        template<typename T, bool checked=true>
+        T cast() const
+        {
+            using V = std::remove_pointer_t<T>;
+
+            if constexpr ( checked )
+            {
+                if ( ops != &detail::storage_ops<std::remove_const_t<V>> )
+                    throw std::bad_any_cast();
+            }
+
+            if constexpr ( std::is_same_v<T, std::remove_pointer_t<T>> )
+                return *(T*)object;
+            else
+                return (V*)object;
+        }
+
+        TypeId type() const { return ops->type; }
+
+        // Object lives here either way, no branch needed to find it.
+        void* data() { return object; }
+        const void* data() const { return object; }
+
+        bool is_inline() const { return object == buffer; }
+        std::pmr::memory_resource* get_resource() const { return resource; }
+
+    private:
+        template<typename T, typename... Args>
+        T& Construct(Args&&... args)
+        {
+            T* value;
+            if constexpr ( fits_inline<T> )
+            {
+                value = new (buffer) T(std::forward<Args>(args)...);
+                if constexpr ( Anyable<T> && sizeof(T) < N )
+                    std::memset(buffer + sizeof(T), 0, N - sizeof(T));
+            }
+            else
+            {
+                void* memory = resource->allocate(sizeof(T), alignof(T));
+                try
+                {
+                    value = new (memory) T(std::forward<Args>(args)...);
+                }
+                catch ( ... )
+                {
+                    resource->deallocate(memory, sizeof(T), alignof(T));
+                    throw;
+                }
+            }
+            object = value;
+            ops = &detail::storage_ops<T>;
+            return *value;
+        }
+
+        // A copy of an empty buffer is empty, as is this if the copy throws.
+        void CopyFrom( const AnyBuffer& other )
+        {
+            const detail::StorageOps* other_ops = other.ops;
+            if ( ! other_ops )
+                return;
+
+            void* memory = other.is_inline() ? buffer : resource->allocate(other_ops->size, other_ops->alignment);
+            if ( other_ops->copy )
+            {
+                try
+                {
+                    other_ops->copy(memory, other.object);
+                }
+                catch ( ... )
+                {
+                    if ( memory != buffer )
+                        resource->deallocate(memory, other_ops->size, other_ops->alignment);
+                    throw;
+                }
+            }
+            else
+                std::memcpy(memory, other.object, other_ops->size);
+
+            object = memory;
+            ops = other_ops;
+        }
+
+        // Heap values are stolen, other is left empty. Moving an empty buffer leaves this empty.
+        void MoveFrom( AnyBuffer& other )
+        {
+            ops = other.ops;
+            if ( ! ops )
+                return;
+
+            if ( other.is_inline() )
+            {
+                object = buffer;
+                if ( ops->move )
+                    ops->move(object, other.object);
+                else
+                    std::memcpy(buffer, other.buffer, N);
+            }
+            else
+            {
+                object = other.object;
+                other.object = nullptr;
+                other.ops = nullptr;
+            }
+        }
+
+        void Destroy()
+        {
+            if ( ! ops )
+                return;
+
+            if ( ops->destroy )
+                ops->destroy(object);
+
+            if ( ! is_inline() )
+                resource->deallocate(object, ops->size, ops->alignment);
+
+            object = nullptr;
+            ops = nullptr;
+        }
+
         alignas(std::max_align_t) std::byte buffer[N];
-        std::size_t type_hash; 
+        void* object = nullptr;
+        const detail::StorageOps* ops = nullptr;
+        std::pmr::memory_resource* resource;
     };
 
-    
+    namespace detail
+    {
+        // std::any can't hand out a pointer without knowing the type so its vtable entries
+        // go through this thunk, which any_casts and then calls Invk directly.
+        template<typename Traits, typename TyMethod, typename T, typename TyFunction = typename TyMethod::template any_pointer<void>>
+        struct StdAnyThunk;
+
+        template<typename Traits, typename TyMethod, typename T, typename Ret, typename V, typename... Args>
+        struct StdAnyThunk<Traits, TyMethod, T, Ret(*)(V*, Args...)>
+        {
+            using any_type = std::conditional_t<std::is_const_v<V>, const std::any, std::any>;
+
+            static Ret Invk( V* storage, Args... args )
+            {
+                auto* value = std::any_cast<T>(static_cast<any_type*>(storage));
+                return TyMethod::template Invk<Traits, TyMethod>(value, std::forward<Args>(args)...);
+            }
+        };
+    }
 
     template<typename TyStorage, typename TraitsType, typename... TyMethods>
     struct AnyValue
     {
         
         using data_pointer = void;
+        using traits_type = detail::policy_traits_t<TraitsType>;
+
+        static constexpr bool is_inline = detail::has_option<InlineLayout, TraitsType>;
 
         template<typename TyMethod, typename T>
         using typed_method_pointer = typename TyMethod::template any_pointer<T>;
@@ -76,17 +410,30 @@ namespace DynTrt
         template<typename TyMethod>
         using method_pointer = typename TyMethod::template any_pointer<data_pointer>;
 
+        // Shares the vtable layout (and for T, the vtable itself) with the matching Trait so
+        // the stored value can be handed out as a Trait without copying, see View.
+        using trait_type = Trait<TraitsType, TyMethods...>;
+
         template<typename T>
-        using vtable = std::tuple<typed_method_pointer<TyMethods,T>...>; //...
+        using vtable = typename trait_type::template vtable<T>;
+
+        using table_type = typename trait_type::table_type;
         
         // Just below we do p(InvokeStatic) where p is the corresponding function type (saved in Method)
         // same way we do vtable above but just passing InvokeStatic in.
 
         AnyValue( const AnyValue& )=default;
-        AnyValue( AnyValue&& )=default;
+        AnyValue( AnyValue&& ) noexcept=default;
+
+        // Copied aside first, a throwing copy must not leave table pointing at an emptied storage.
+        AnyValue& operator=( const AnyValue& other )
+        {
+            if ( this != &other )
+                *this = AnyValue(other);
+            return *this;
+        }
 
-        AnyValue& operator=( const AnyValue& )=default;
-        AnyValue& operator=( AnyValue&& )=default;
+        AnyValue& operator=( AnyValue&& ) noexcept=default;
 
         // 
         // Draw
@@ -95,61 +442,196 @@ namespace DynTrt
 
         template<typename T>
         requires( 
-            (HasOverload<TraitsType, T, TyMethods> && ...)
+            ! std::same_as<std::remove_cvref_t<T>, AnyValue> &&
+            (HasOverload<traits_type, std::remove_cvref_t<T>, TyMethods> && ...)
         )
-        AnyValue( const T& value ): 
-            storage(std::move(value))
+        AnyValue( T&& value ): 
+            storage(std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value))
             //table(  ) // Fucking horrible why can't we just expand type_sequence...
         {
-            static vtable<T> static_table = 
-            std::make_tuple(
-                typed_method_pointer<TyMethods,T>(&TraitsType::template Invoke<TyMethods>)... 
-            );
-            //static vtable static_table = std::make_tuple(method_pointer<TyMethods>(InvokeStatic<TyMethods, T>)... );
-            table = reinterpret_cast<vtable<void>*>(&static_table);
+            SetTable<std::remove_cvref_t<T>>();
+        }
+
+        /// Constructs a T directly in the storage, no temporary is made.
+        template<typename T, typename... Args>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        explicit AnyValue( std::in_place_type_t<T>, Args&&... args ): 
+            storage(std::in_place_type<T>, std::forward<Args>(args)...)
+        {
+            SetTable<T>();
+        }
+
+        template<typename T, typename... Args>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        T& emplace( Args&&... args )
+        {
+            // Built aside and moved in, if the constructor throws the current value is untouched.
+            if constexpr ( requires { storage.get_resource(); } )
+                *this = AnyValue(std::allocator_arg, storage.get_resource(), std::in_place_type<T>, std::forward<Args>(args)...);
+            else
+                *this = AnyValue(std::in_place_type<T>, std::forward<Args>(args)...);
+
+            if constexpr ( is_std_any )
+                return *std::any_cast<T>(&storage);
+            else
+                return *storage.template cast<T*,false>();
+        }
+
+        /// As above but allocating from resource when the value does not fit inline (AnyBuffer only).
+        template<typename T>
+        requires( 
+            (HasOverload<traits_type, std::remove_cvref_t<T>, TyMethods> && ...)
+        )
+        AnyValue( std::allocator_arg_t, std::pmr::memory_resource* resource, T&& value ): 
+            storage(std::allocator_arg, resource, std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(value))
+        {
+            SetTable<std::remove_cvref_t<T>>();
+        }
+
+        template<typename T, typename... Args>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        AnyValue( std::allocator_arg_t, std::pmr::memory_resource* resource, std::in_place_type_t<T>, Args&&... args ): 
+            storage(std::allocator_arg, resource, std::in_place_type<T>, std::forward<Args>(args)...)
+        {
+            SetTable<T>();
         }
 
     private:
-        template<typename Ty>
-        static Ty Cast( const std::any& storage ) { std::any_cast<Ty>(storage); }
+        static constexpr bool is_std_any = std::same_as<TyStorage, std::any>;
+
+        // Pointer handed to the vtable functions. std::any passes itself, see StdAnyThunk.
+        inline void* Data()
+        {
+            if constexpr ( is_std_any )
+                return &storage;
+            else
+                return storage.data();
+        }
+
+        inline const void* Data() const
+        {
+            if constexpr ( is_std_any )
+                return &storage;
+            else
+                return storage.data();
+        }
+
 
-        template<typename Ty, bool check=false>
-        static Ty Cast( const TyStorage& storage ) { return storage.template cast<Ty,check>(); } // not checked here since we are casting
     public:
         template<typename TyMethod, typename... Ts>
         requires (
             BoundMethod<TyMethod,TyMethods...> &&
-            std::same_as<typename TyMethod::arguments, detail::type_sequence<Ts...>>
+            TyMethod::template callable_with<Ts...>
         )
-        auto Call(Ts... args)
+        decltype(auto) Call(Ts&&... args)
         {
             constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
-            return std::get<n>(*table)(&storage, args...);
+            return detail::get<n>(trait_type::Entries(table))(Data(), std::forward<Ts>(args)...);
         }
 
         template<typename TyMethod, typename... Ts>
         requires (
             BoundMethod<TyMethod,TyMethods...> &&
-            std::same_as<typename TyMethod::arguments, detail::type_sequence<Ts...>>
+            TyMethod::template callable_with<Ts...>
         )
-        auto Call(Ts... args) const
+        decltype(auto) Call(Ts&&... args) const
         {
             constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
-            return std::get<n>(*table)(&storage, args...);
+            return detail::get<n>(trait_type::Entries(table))(Data(), std::forward<Ts>(args)...);
         }
 
+        /// Throws std::bad_any_cast if the value is not a T.
         template<typename T>
-        T& Get() { return *storage.template cast<T*,true>(); }
+        T& Get()
+        {
+            if constexpr ( is_std_any )
+                return std::any_cast<T&>(storage);
+            else
+                return *storage.template cast<T*,true>();
+        }
+
+        /// Non-owning Trait over the stored value, valid until the value is replaced or destroyed.
+        /// If the trait is Narrowable TyTrait may have any subset of our methods (in the same order),
+        /// the vtable comes from the stored type's projections so no type knowledge is needed.
+        ///     Shape::Moveable moveable = any_shape.View<Shape::Moveable>();
+        template<typename TyTrait = trait_type>
+        TyTrait View()
+        {
+            static_assert( ! is_std_any, "View needs a pointer to the value, not available for StdAny" );
+            return TyTrait(trait_type::FromTable(Table(), Data()));
+        }
+
+        template<typename TyTrait = trait_type>
+        const TyTrait View() const
+        {
+            static_assert( ! is_std_any, "View needs a pointer to the value, not available for StdAny" );
+            return TyTrait(trait_type::FromTable(trait_type::ConstTable(Table()), const_cast<void*>(Data())));
+        }
 
     private:
-        vtable<void>* table;
+        template<typename T>
+        void SetTable()
+        {
+            if constexpr ( is_std_any )
+                SetTable(StdAnyTable<T>());
+            else
+                SetTable(trait_type::template StaticTable<T, false>());
+        }
+
+        template<typename T>
+        static constexpr const vtable<void>& StdAnyTable()
+        {
+            return std_any_table<T>;
+        }
+
+        template<typename TyMethod, typename T>
+        static constexpr method_pointer<TyMethod> StdAnyEntry()
+        {
+            constexpr method_pointer<TyMethod> function = &detail::StdAnyThunk<traits_type, TyMethod, T>::Invk;
+            return detail::wrap_entry<TraitsType, AnyValue, TyMethod, T, function>();
+        }
+
+        template<typename T>
+        static constexpr vtable<void> std_any_table{
+            StdAnyEntry<TyMethods,T>()..., 
+            typename trait_type::TypeInfo{ type_id<T>, nullptr }
+        };
+
+        void SetTable( const vtable<void>& static_table )
+        {
+            table = trait_type::MakeTable(static_table);
+        }
+
+        inline const vtable<void>& Table() const
+        {
+            return trait_type::StaticTableOf(table);
+        }
+
+        // Loading a Snapshot (see Snapshot.h) patches table and the storage's ops in place.
+        template<typename, typename...>
+        friend struct Snapshot;
+
+        table_type table;
         TyStorage storage;
     };
 
     template<size_t N, typename TraitsType, typename... TyMethods>
     using AnySmall = AnyValue<AnyStorage<N>, TraitsType, TyMethods...>;
 
+    template<size_t N, typename TraitsType, typename... TyMethods>
+    using AnyBuffered = AnyValue<AnyBuffer<N>, TraitsType, TyMethods...>;
+
+    template<typename TraitsType, typename... TyMethods>
+    using Any = AnyValue<AnyBuffer<>, TraitsType, TyMethods...>;
+
+    // Previous std::any backed Any, kept for comparison.
     template<typename TraitsType, typename... TyMethods>
-    using Any = AnyValue<std::any, TraitsType, TyMethods...>;
+    using StdAny = AnyValue<std::any, TraitsType, TyMethods...>;
 }
 
@@ -0,0 +1,199 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <ranges>
+#include <span>
+#include "DynTrt.h"
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#include <xmmintrin.h>
+#endif
+
+namespace DynTrt
+{
+    namespace detail
+    {
+        inline void prefetch( const void* address )
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(address);
+#elif defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+            _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+            (void)address;
+#endif
+        }
+
+        // How many handles ahead of the current call we touch the object data.
+        inline constexpr std::size_t prefetch_distance = 4;
+
+        // Most objects handed to one batch entry call, bounds the gather buffer on the stack.
+        inline constexpr std::size_t batch_chunk = 256;
+
+        template<typename TyMethod>
+        concept batch_method = requires { TyMethod::is_batch; } && TyMethod::is_batch;
+
+        // Everything of BatchMethod that needs the scalar method's argument pack.
+        template<typename TraitsType, typename TyMethod, typename TyArguments>
+        struct BatchSignature;
+
+        template<typename TraitsType, typename TyMethod, typename... Args>
+        struct BatchSignature<TraitsType, TyMethod, type_sequence<Args...>>
+        {
+            static constexpr bool is_batch = true;
+            static constexpr bool is_const = TyMethod::is_const;
+
+            using scalar_method = TyMethod;
+            using return_type = void;
+            using arguments = type_sequence<Args...>;
+
+            template<typename Ty>
+            using const_correct = typename TyMethod::template const_correct<Ty>;
+
+            template<typename TyStorage>
+            using any_pointer = void(*)(const_correct<TyStorage>* const* objects, std::size_t count, Args...);
+
+            template<typename... Ts>
+            static constexpr bool callable_with = TyMethod::template callable_with<Ts...>;
+
+            // Entry stored in vtables, hands each contiguous stretch of the run to Invoke.
+            template<typename Trait, typename TyBatch, typename Ty>
+            static void Erased( const_correct<void>* const* objects, std::size_t count, Args... args )
+            {
+                using object_type = const_correct<Ty>;
+                std::size_t begin = 0;
+                while ( begin < count )
+                {
+                    object_type* first = static_cast<object_type*>(objects[begin]);
+                    std::size_t end = begin + 1;
+                    while ( end < count && objects[end] == first + (end - begin) )
+                        end++;
+
+                    Contiguous<TyBatch>( std::span<object_type>(first, end - begin), args... );
+                    begin = end;
+                }
+            }
+
+            // Calls TyBatch's Invoke, which may be specialised for Ty, on objects already in one array.
+            template<typename TyBatch, typename Ty>
+            static void Contiguous( std::span<Ty> objects, Args... args )
+            {
+                TyBatch::template Invoke<Ty, Args...>( objects, args... );
+            }
+
+            // Only used unevaluated (see HasOverload), a type has the batch method if it has the scalar one.
+            template<typename Trait, typename Ty, typename>
+            requires( HasOverload<Trait, Ty, TyMethod> )
+            static void DummyInvoke();
+        };
+    }
+
+    /// Batch flavour of the scalar method TyMethod. Its vtable entry is called once per run of
+    /// handles of the same type with every object of the run, and each contiguous stretch of
+    /// them is handed to Invoke as one span:
+    ///     using MoveAll = DynTrt::BatchMethod<Shape, Move>;
+    ///     using Moveable = DynTrt::Trait<Shape, Move, MoveAll>;
+    ///     DynTrt::BatchCall<Shape::MoveAll>( shapes, 0.5, 0.25 );
+    /// The default Invoke calls TyMethod on each object, a type can specialise it with a kernel:
+    ///     template<> template<>
+    ///     void DynTrt::BatchMethod<Shape, Shape::Move>::Invoke( std::span<Circle> circles, double x, double y ) { ... }
+    /// Objects are only contiguous when the handles point into one array in order, so keep
+    /// handles in the order of the storage they were made from.
+    template<typename TraitsType, typename TyMethod>
+    requires( std::is_void_v<typename TyMethod::return_type> )
+    struct BatchMethod : detail::BatchSignature<TraitsType, TyMethod, typename TyMethod::arguments>
+    {
+        template<typename T, typename... Ts>
+        static void Invoke( std::span<T> objects, Ts... args )
+        {
+            for ( T& object : objects )
+                TyMethod::template Invk<detail::policy_traits_t<TraitsType>, TyMethod>(&object, args...);
+        }
+    };
+
+    /// Reorders handles so all handles of the same concrete type are adjacent.
+    /// Relative order within each type is preserved.
+    template<std::ranges::contiguous_range TyRange>
+    inline void Partition( TyRange&& range )
+    {
+        std::span handles{range};
+        std::stable_sort( handles.begin(), handles.end(), []( const auto& a, const auto& b ) {
+            return std::less<>{}( a.Identity(), b.Identity() );
+        });
+    }
+
+    /// Calls TyMethod on every handle in range, in order.
+    /// Consecutive handles of the same type are called as one run: the function pointer
+    /// is loaded once and every call in the run goes to the same target. Partition first
+    /// (or keep the collection grouped by type) to get long runs.
+    /// Arguments are passed to every call so they are never moved from.
+    /// For a BatchMethod the whole run is passed to one call.
+    template<typename TyMethod, std::ranges::contiguous_range TyRange, typename... Ts>
+    requires (
+        TyMethod::template callable_with<Ts&...> &&
+        ( TyMethod::is_const || ! std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<TyRange>>> )
+    )
+    inline void BatchCall( TyRange&& range, Ts&&... args )
+    {
+        std::span handles{range};
+        const std::size_t count = handles.size();
+
+        std::size_t i = 0;
+        if constexpr ( detail::batch_method<TyMethod> )
+        {
+            // One call per run (or per batch_chunk handles of a run) with the gathered objects.
+            std::array<void*, detail::batch_chunk> objects;
+            while ( i < count )
+            {
+                const void* identity = handles[i].Identity();
+                const auto function = handles[i].template Function<TyMethod>();
+
+                std::size_t gathered = 0;
+                for ( ; i < count && gathered < objects.size() && handles[i].Identity() == identity; i++ )
+                    objects[gathered++] = handles[i].pointer;
+
+                function( objects.data(), gathered, args... );
+            }
+        }
+        else
+        {
+            while ( i < count )
+            {
+                const void* identity = handles[i].Identity();
+                const auto function = handles[i].template Function<TyMethod>();
+
+                for ( ; i < count && handles[i].Identity() == identity; i++ )
+                {
+                    if ( i + detail::prefetch_distance < count )
+                        detail::prefetch( handles[i + detail::prefetch_distance].pointer );
+
+                    function( handles[i].pointer, args... );
+                }
+            }
+        }
+    }
+}
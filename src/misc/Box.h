@@ -0,0 +1,352 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    namespace detail
+    {
+        // Vtable of a Box: the trait's own static vtable, so views share its Identity, and
+        // how to destroy the object.
+        template<typename TyTrait>
+        struct BoxTable
+        {
+            const typename TyTrait::template vtable<void>* methods;
+            void (*destroy)( void* object );
+        };
+    }
+
+    class Arena;
+
+    /// Owning handle: a pointer and a vtable like Trait, whose vtable also knows how to destroy
+    /// the object. Move only, the object is destroyed with the Box.
+    ///     auto shape = DynTrt::Box<Shape::Drawable>::Make<Circle>( 1.0 );   // new Circle
+    ///     auto other = arena.MakeBox<Shape::Drawable, Circle>( 1.0 );       // see Arena
+    ///     shape.Call<Shape::Draw>( 255, 0, 0 );
+    ///     Shape::Drawable view = shape.View();                              // non-owning
+    template<typename TyTrait>
+    class Box;
+
+    template<typename TraitsType, typename... TyMethods>
+    class Box<Trait<TraitsType, TyMethods...>>
+    {
+    public:
+        using trait_type = Trait<TraitsType, TyMethods...>;
+        using traits_type = typename trait_type::traits_type;
+        using table_type = detail::BoxTable<trait_type>;
+
+        template<typename TyMethod>
+        using method_pointer = typename trait_type::template method_pointer<TyMethod>;
+
+        /// Empty, as is a Box that has been moved from.
+        constexpr Box()=default;
+
+        Box( Box&& other ) noexcept: table(std::exchange(other.table, nullptr)), pointer(std::exchange(other.pointer, nullptr)) {}
+
+        Box& operator=( Box&& other ) noexcept
+        {
+            if ( this != &other )
+            {
+                Reset();
+                table = std::exchange(other.table, nullptr);
+                pointer = std::exchange(other.pointer, nullptr);
+            }
+            return *this;
+        }
+
+        Box( const Box& )=delete;
+        Box& operator=( const Box& )=delete;
+
+        ~Box() { Reset(); }
+
+        /// Allocates a T with new, destroyed with delete.
+        template<typename T, typename... Args>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        static Box Make( Args&&... args )
+        {
+            return Box( heap_table<T>, new T(std::forward<Args>(args)...) );
+        }
+
+        /// Destroys the object, leaving the Box empty.
+        void Reset()
+        {
+            if ( pointer )
+                table->destroy( pointer );
+
+            table = nullptr;
+            pointer = nullptr;
+        }
+
+        explicit operator bool() const { return pointer != nullptr; }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            BoundMethod<TyMethod,TyMethods...> &&
+            ! TyMethod::is_const &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args)
+        {
+            return Function<TyMethod>()(pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            TyMethod::is_const &&
+            BoundMethod<TyMethod,TyMethods...> &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            return Function<TyMethod>()(pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod>
+        requires ( BoundMethod<TyMethod,TyMethods...> )
+        inline method_pointer<TyMethod> Function() const
+        {
+            constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
+            return detail::get<n>(*table->methods);
+        }
+
+        /// Non-owning Trait over the object, valid while the Box holds it. TyTrait may have any
+        /// subset of our methods (in the same order) if the trait is Narrowable.
+        template<typename TyTrait = trait_type>
+        TyTrait View()
+        {
+            return TyTrait(trait_type::FromTable(*table->methods, pointer));
+        }
+
+        /// As for a Trait made from a const pointer, Get only gives out a const T*.
+        template<typename TyTrait = trait_type>
+        const TyTrait View() const
+        {
+            return TyTrait(trait_type::FromTable(trait_type::ConstTable(*table->methods), pointer));
+        }
+
+        TypeId Type() const
+        {
+            return detail::get<typename trait_type::TypeInfo>(*table->methods).type;
+        }
+
+        template<typename T>
+        T* Get()
+        {
+            return pointer && Type() == type_id<T> ? static_cast<T*>(pointer) : nullptr;
+        }
+
+        template<typename T>
+        const T* Get() const
+        {
+            return pointer && Type() == type_id<T> ? static_cast<const T*>(pointer) : nullptr;
+        }
+
+    private:
+        friend class Arena;
+
+        Box( const table_type& table, void* pointer ): table(&table), pointer(pointer) {}
+
+        template<typename T>
+        static void Delete( void* object )
+        {
+            delete static_cast<T*>(object);
+        }
+
+        template<typename T>
+        static constexpr table_type heap_table{ &trait_type::template StaticTable<T, false>(), &Delete<T> };
+
+        const table_type* table = nullptr;
+        void* pointer = nullptr;
+    };
+
+    /// Bump allocator for object graphs: objects are constructed next to each other in large
+    /// blocks and destroyed together, so building thousands of objects costs a few allocations.
+    ///     DynTrt::Arena arena;
+    ///     Circle* circle = arena.New<Circle>( 1.0 );
+    ///     Shape::Drawable drawable = arena.Make<Shape::Drawable, Circle>( 1.0 );
+    ///     arena.Reset();   // destroys both, in reverse order
+    /// MakeBox gives an owning Box instead. Its object is destroyed with the Box and the memory
+    /// goes on a free list for the type, which the next MakeBox of that type reuses. Boxes must
+    /// be destroyed before the arena is reset or destroyed. Not thread safe.
+    class Arena
+    {
+    public:
+        static constexpr std::size_t default_block_size = 64 * 1024;
+
+        explicit Arena( std::size_t block_size = default_block_size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource() ):
+            resource(block_size, upstream)
+        {}
+
+        Arena( const Arena& )=delete;
+        Arena& operator=( const Arena& )=delete;
+
+        ~Arena() { Reset(); }
+
+        /// Constructs a T owned by the arena, destroyed by Reset.
+        template<typename T, typename... Args>
+        T* New( Args&&... args )
+        {
+            if constexpr ( ! std::is_trivially_destructible_v<T> )
+            {
+                if ( destructors.size() == destructors.capacity() )
+                    destructors.reserve( destructors.empty() ? 64 : destructors.size() * 2 );
+            }
+
+            T* object = new (resource.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+            if constexpr ( ! std::is_trivially_destructible_v<T> )
+                destructors.push_back( { object, &Destroy<T> } );
+
+            return object;
+        }
+
+        /// Non-owning handle to a new T owned by the arena.
+        template<typename TyTrait, typename T, typename... Args>
+        TyTrait Make( Args&&... args )
+        {
+            return TyTrait( New<T>(std::forward<Args>(args)...) );
+        }
+
+        /// Owning handle to a new T in the arena's memory.
+        template<typename TyTrait, typename T, typename... Args>
+        Box<TyTrait> MakeBox( Args&&... args )
+        {
+            void* object = AllocateSlot<T>();
+            try
+            {
+                new (object) T(std::forward<Args>(args)...);
+            }
+            catch ( ... )
+            {
+                PushFree( detail::type_index<T>(), object );
+                throw;
+            }
+
+            boxes++;
+            return Box<TyTrait>( box_table<TyTrait, T>, object );
+        }
+
+        /// Destroys every object made by New and Make, most recent first, and releases the
+        /// memory. Boxes must already have been destroyed.
+        void Reset()
+        {
+            assert( boxes == 0 && "Boxes from an arena must be destroyed before it is reset" );
+
+            for ( auto destructor = destructors.rbegin(); destructor != destructors.rend(); destructor++ )
+                destructor->destroy( destructor->object );
+
+            destructors.clear();
+            free_lists.clear();
+            resource.release();
+        }
+
+        /// The arena as a memory resource, for example to put AnyBuffer spills in it. Memory is
+        /// only reclaimed by Reset.
+        std::pmr::memory_resource* Resource() { return &resource; }
+
+        /// Boxes made by this arena that are still alive.
+        std::size_t Boxes() const { return boxes; }
+
+    private:
+        struct Destructor
+        {
+            void* object;
+            void (*destroy)( void* object );
+        };
+
+        template<typename T>
+        static void Destroy( void* object )
+        {
+            static_cast<T*>(object)->~T();
+        }
+
+        // Boxed objects are preceded by a header slot. While the object lives it holds the
+        // arena, once freed it links to the next free object of the same type.
+        static void*& Header( void* object )
+        {
+            return *reinterpret_cast<void**>(static_cast<std::byte*>(object) - sizeof(void*));
+        }
+
+        template<typename T>
+        static constexpr std::size_t header_size = ( sizeof(void*) + alignof(T) - 1 ) / alignof(T) * alignof(T);
+
+        // The free list for T is made here, so Recycle (called from ~Box) never allocates.
+        template<typename T>
+        void* AllocateSlot()
+        {
+            const std::uint32_t index = detail::type_index<T>();
+            if ( index >= free_lists.size() )
+                free_lists.resize( index + 1, nullptr );
+
+            void* object;
+            if ( free_lists[index] )
+            {
+                object = free_lists[index];
+                free_lists[index] = Header(object);
+            }
+            else
+            {
+                constexpr std::size_t alignment = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+                object = static_cast<std::byte*>(resource.allocate(header_size<T> + sizeof(T), alignment)) + header_size<T>;
+            }
+            Header(object) = this;
+            return object;
+        }
+
+        void PushFree( std::uint32_t index, void* object ) noexcept
+        {
+            Header(object) = free_lists[index];
+            free_lists[index] = object;
+        }
+
+        template<typename T>
+        static void Recycle( void* object )
+        {
+            Arena* arena = static_cast<Arena*>(Header(object));
+            static_cast<T*>(object)->~T();
+            arena->boxes--;
+            arena->PushFree( detail::type_index<T>(), object );
+        }
+
+        template<typename TyTrait, typename T>
+        static constexpr detail::BoxTable<TyTrait> box_table{ &TyTrait::template StaticTable<T, false>(), &Recycle<T> };
+
+        std::pmr::monotonic_buffer_resource resource;
+        std::vector<Destructor> destructors;
+        // Indexed by detail::type_index, head of the free objects of that type.
+        std::vector<void*> free_lists;
+        std::size_t boxes = 0;
+    };
+}
@@ -0,0 +1,221 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    /// Trait over a known set of types. The value is stored inline with a one byte tag
+    /// and calls are dispatched with a chain of tag compares (which compilers turn into a
+    /// jump table) straight to each type's Invk, so everything can be inlined.
+    ///
+    ///     using Shapes = DynTrt::ClosedTrait<Shape, DynTrt::Types<Circle, Rectangle>, Draw, Move>;
+    ///     Shapes shape = Circle{};
+    ///     shape.Call<Shape::Move>(0.5, 0.25);
+    /// If a move assignment throws while constructing the new value the trait is left
+    /// Valueless, and may only be assigned to or destroyed.
+    template<typename TraitsType, typename TyTypes, typename... TyMethods>
+    struct ClosedTrait;
+
+    template<typename TraitsType, typename... TyTypes, typename... TyMethods>
+    struct ClosedTrait<TraitsType, Types<TyTypes...>, TyMethods...>
+    {
+    public:
+        using traits_type = detail::policy_traits_t<TraitsType>;
+        using tag_type = std::uint8_t;
+
+        static_assert( sizeof...(TyTypes) > 0, "ClosedTrait needs at least one type" );
+        // Tag of a trait holding nothing. Types outside the set get the tag sizeof...(TyTypes),
+        // which must not be a valid tag either.
+        static constexpr tag_type valueless = 255;
+        static_assert( sizeof...(TyTypes) < valueless, "Too many types for a one byte tag" );
+
+        template<typename T>
+        static constexpr bool implements = (HasOverload<traits_type, T, TyMethods> && ...);
+
+        static_assert( (implements<TyTypes> && ...), "Every type must implement every method" );
+
+        static constexpr std::size_t size = std::max({ sizeof(TyTypes)... });
+        static constexpr std::size_t alignment = std::max({ alignof(TyTypes)... });
+
+        template<typename T>
+        static constexpr tag_type tag_of = static_cast<tag_type>(detail::index_in_pack<T, TyTypes...>::value);
+
+    public:
+        template<typename T>
+        requires( BoundMethod<std::remove_cvref_t<T>, TyTypes...> )
+        ClosedTrait( T&& value ): tag(tag_of<std::remove_cvref_t<T>>)
+        {
+            new (buffer) std::remove_cvref_t<T>(std::forward<T>(value));
+        }
+
+        ClosedTrait( const ClosedTrait& other ): tag(other.tag)
+        {
+            if ( tag != valueless )
+                other.Visit([this]<typename T>( const T* value ) { new (buffer) T(*value); });
+        }
+
+        ClosedTrait( ClosedTrait&& other ): tag(other.tag)
+        {
+            if ( tag != valueless )
+                other.Visit([this]<typename T>( T* value ) { new (buffer) T(std::move(*value)); });
+        }
+
+        // Copies first, so a throwing copy leaves this unchanged.
+        ClosedTrait& operator=( const ClosedTrait& other )
+        {
+            if ( this != &other )
+            {
+                ClosedTrait copy = other;
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        ClosedTrait& operator=( ClosedTrait&& other )
+        {
+            if ( this != &other )
+            {
+                Destroy();
+                if ( other.tag == valueless )
+                    return *this;
+
+                other.Visit([this]<typename T>( T* value ) { 
+                    new (buffer) T(std::move(*value)); 
+                    tag = tag_of<T>;
+                });
+            }
+            return *this;
+        }
+
+        ~ClosedTrait() { Destroy(); }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            BoundMethod<TyMethod,TyMethods...> &&
+            ! TyMethod::is_const &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args)
+        {
+            return Visit([&]( auto* value ) -> typename TyMethod::return_type {
+                return TyMethod::template Invk<traits_type, TyMethod>(value, std::forward<Ts>(args)...);
+            });
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            TyMethod::is_const &&
+            BoundMethod<TyMethod,TyMethods...> &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            return Visit([&]( auto* value ) -> typename TyMethod::return_type {
+                return TyMethod::template Invk<traits_type, TyMethod>(value, std::forward<Ts>(args)...);
+            });
+        }
+
+        template<typename T>
+        inline T* Get()
+        {
+            if ( tag != tag_of<T> )
+                return nullptr;
+
+            return std::launder(reinterpret_cast<T*>(buffer));
+        }
+
+        template<typename T>
+        inline const T* Get() const
+        {
+            if ( tag != tag_of<T> )
+                return nullptr;
+
+            return std::launder(reinterpret_cast<const T*>(buffer));
+        }
+
+        inline tag_type Tag() const { return tag; }
+
+        inline bool Valueless() const { return tag == valueless; }
+
+        /// Calls f with a typed pointer to the stored value.
+        template<typename F>
+        inline decltype(auto) Visit( F&& f )
+        {
+            return VisitFrom<0>(std::forward<F>(f));
+        }
+
+        template<typename F>
+        inline decltype(auto) Visit( F&& f ) const
+        {
+            return VisitFrom<0>(std::forward<F>(f));
+        }
+
+    private:
+        // Last type needs no compare, tag must be valid.
+        template<std::size_t I, typename F>
+        inline decltype(auto) VisitFrom( F&& f )
+        {
+            using T = detail::type_at_t<I, TyTypes...>;
+            if constexpr ( I + 1 == sizeof...(TyTypes) )
+                return f(std::launder(reinterpret_cast<T*>(buffer)));
+            else
+            {
+                if ( tag == I )
+                    return f(std::launder(reinterpret_cast<T*>(buffer)));
+                return VisitFrom<I + 1>(std::forward<F>(f));
+            }
+        }
+
+        template<std::size_t I, typename F>
+        inline decltype(auto) VisitFrom( F&& f ) const
+        {
+            using T = detail::type_at_t<I, TyTypes...>;
+            if constexpr ( I + 1 == sizeof...(TyTypes) )
+                return f(std::launder(reinterpret_cast<const T*>(buffer)));
+            else
+            {
+                if ( tag == I )
+                    return f(std::launder(reinterpret_cast<const T*>(buffer)));
+                return VisitFrom<I + 1>(std::forward<F>(f));
+            }
+        }
+
+        inline void Destroy()
+        {
+            if ( tag == valueless )
+                return;
+
+            Visit([]<typename T>( T* value ) { value->~T(); });
+            tag = valueless;
+        }
+
+        alignas(alignment) std::byte buffer[size];
+        tag_type tag;
+    };
+}
@@ -0,0 +1,260 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "DynTrt.h"
+#include "Batch.h"
+
+namespace DynTrt
+{
+    /// Container storing each concrete type in its own contiguous array (column). Elements are
+    /// referred to by generational handles which stay valid across inserts and erases of other
+    /// elements, and a handle to an erased element is detected rather than reused.
+    /// Calls over the whole container go column by column, calling each type's Invk directly,
+    /// so there is no indirect call per element (and a BatchMethod gets each column as one span).
+    ///     DynTrt::PolyColumns<Shape::Moveable, Circle, Rectangle> shapes;
+    ///     auto handle = shapes.Insert( Circle{} );
+    ///     shapes.Call<Shape::Move>( 0.5, 0.25 );
+    ///     Shape::Moveable moveable = shapes.At( handle );
+    /// Erase moves the last element of the column into the gap, so wide pointers from At and
+    /// spans from Column are only valid until the next insert or erase of that type.
+    template<typename TyTrait, typename... TyTypes>
+    class PolyColumns
+    {
+    public:
+        using trait_type = TyTrait;
+        using traits_type = typename TyTrait::traits_type;
+        using index_type = std::uint32_t;
+
+        static_assert( sizeof...(TyTypes) > 0, "PolyColumns needs at least one type" );
+        static_assert( (std::constructible_from<TyTrait, TyTypes*> && ...), "Every type must implement the trait" );
+
+        struct Handle
+        {
+            index_type slot = 0;
+            // Generations start at 1 so a default constructed handle is never valid.
+            index_type generation = 0;
+
+            bool operator==( const Handle& ) const = default;
+        };
+
+        template<typename T>
+        static constexpr std::size_t column_of = detail::index_in_pack<T, TyTypes...>::value;
+
+    public:
+        template<typename T, typename... Ts>
+        requires( BoundMethod<T, TyTypes...> )
+        Handle Emplace( Ts&&... args )
+        {
+            ColumnData<T>& column = std::get<column_of<T>>(columns);
+            if ( column.values.size() == std::numeric_limits<index_type>::max() )
+                throw std::length_error("PolyColumns column is full");
+
+            // Everything that can allocate happens before the value is added, so a throw
+            // leaves the columns as they were.
+            ReserveOne( column.slots );
+            if ( free_slots.empty() )
+                ReserveOne( slots );
+
+            const index_type position = static_cast<index_type>(column.values.size());
+            column.values.emplace_back( std::forward<Ts>(args)... );
+
+            const index_type slot = Allocate( column_of<T>, position );
+            column.slots.push_back( slot );
+            return { slot, slots[slot].generation };
+        }
+
+        template<typename T>
+        requires( BoundMethod<std::remove_cvref_t<T>, TyTypes...> )
+        Handle Insert( T&& value )
+        {
+            return Emplace<std::remove_cvref_t<T>>( std::forward<T>(value) );
+        }
+
+        /// Returns false if handle was already erased.
+        bool Erase( Handle handle )
+        {
+            if ( ! Contains(handle) )
+                return false;
+
+            Slot& slot = slots[handle.slot];
+            VisitColumn( slot.column, [&]( auto& column ) {
+                const index_type last = static_cast<index_type>(column.values.size() - 1);
+                if ( slot.position != last )
+                {
+                    column.values[slot.position] = std::move(column.values[last]);
+                    column.slots[slot.position] = column.slots[last];
+                    slots[column.slots[last]].position = slot.position;
+                }
+                column.values.pop_back();
+                column.slots.pop_back();
+            });
+
+            slot.generation++;
+            free_slots.push_back( handle.slot );
+            count--;
+            return true;
+        }
+
+        bool Contains( Handle handle ) const
+        {
+            return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation;
+        }
+
+        /// Null if handle was erased or does not refer to a T.
+        template<typename T>
+        T* Get( Handle handle )
+        {
+            return const_cast<T*>(std::as_const(*this).template Get<T>(handle));
+        }
+
+        template<typename T>
+        const T* Get( Handle handle ) const
+        {
+            if ( ! Contains(handle) || slots[handle.slot].column != column_of<T> )
+                return nullptr;
+
+            return &std::get<column_of<T>>(columns).values[slots[handle.slot].position];
+        }
+
+        /// Wide pointer to the element, throws std::out_of_range if handle was erased.
+        TyTrait At( Handle handle )
+        {
+            if ( ! Contains(handle) )
+                throw std::out_of_range("PolyColumns handle was erased");
+
+            const Slot& slot = slots[handle.slot];
+            return VisitColumn( slot.column, [&]( auto& column ) { return TyTrait( &column.values[slot.position] ); } );
+        }
+
+        /// Calls TyMethod on every element, one column at a time.
+        template<typename TyMethod, typename... Ts>
+        requires ( ! TyMethod::is_const && TyMethod::template callable_with<Ts&...> )
+        void Call( Ts&&... args )
+        {
+            std::apply( [&]( auto&... column ) { (CallColumn<TyMethod>( std::span{column.values}, args... ), ...); }, columns );
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires ( TyMethod::is_const && TyMethod::template callable_with<Ts&...> )
+        void Call( Ts&&... args ) const
+        {
+            std::apply( [&]( const auto&... column ) { (CallColumn<TyMethod>( std::span{column.values}, args... ), ...); }, columns );
+        }
+
+        template<typename T>
+        std::span<T> Column() { return std::get<column_of<T>>(columns).values; }
+
+        template<typename T>
+        std::span<const T> Column() const { return std::get<column_of<T>>(columns).values; }
+
+        std::size_t Size() const { return count; }
+        bool Empty() const { return count == 0; }
+
+    private:
+        template<typename T>
+        struct ColumnData
+        {
+            std::vector<T> values;
+            // Slot of each value, to fix up the slot of the value moved by an erase.
+            std::vector<index_type> slots;
+        };
+
+        struct Slot
+        {
+            index_type generation;
+            index_type position;
+            std::uint8_t column;
+        };
+
+        static_assert( sizeof...(TyTypes) <= 256, "Too many types for a one byte column index" );
+
+        template<typename TyMethod, typename T, typename... Ts>
+        static void CallColumn( std::span<T> values, Ts&... args )
+        {
+            if constexpr ( detail::batch_method<TyMethod> )
+            {
+                if ( ! values.empty() )
+                    TyMethod::template Contiguous<TyMethod>( values, args... );
+            }
+            else
+            {
+                for ( T& value : values )
+                    TyMethod::template Invk<traits_type, TyMethod>( &value, args... );
+            }
+        }
+
+        // Makes room for one more element, growing geometrically.
+        template<typename V>
+        static void ReserveOne( std::vector<V>& values )
+        {
+            if ( values.size() == values.capacity() )
+                values.reserve( values.empty() ? 16 : values.size() * 2 );
+        }
+
+        index_type Allocate( std::size_t column, index_type position )
+        {
+            index_type slot;
+            if ( ! free_slots.empty() )
+            {
+                slot = free_slots.back();
+                free_slots.pop_back();
+            }
+            else
+            {
+                slot = static_cast<index_type>(slots.size());
+                slots.push_back( { 1, 0, 0 } );
+            }
+            slots[slot].position = position;
+            slots[slot].column = static_cast<std::uint8_t>(column);
+            count++;
+            return slot;
+        }
+
+        // Calls f with the column at index, the index must be valid.
+        template<typename F, std::size_t I = 0>
+        decltype(auto) VisitColumn( std::size_t index, F&& f )
+        {
+            if constexpr ( I + 1 == sizeof...(TyTypes) )
+                return f( std::get<I>(columns) );
+            else
+            {
+                if ( index == I )
+                    return f( std::get<I>(columns) );
+                return VisitColumn<F, I + 1>( index, std::forward<F>(f) );
+            }
+        }
+
+        std::tuple<ColumnData<TyTypes>...> columns;
+        std::vector<Slot> slots;
+        std::vector<index_type> free_slots;
+        std::size_t count = 0;
+    };
+}
@@ -0,0 +1,275 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    /// Records calls to replay later. Arguments are stored by value in a chunked arena next to
+    /// the vtable entry, so recording does not allocate once the arena has grown.
+    /// Flush runs every command and groups the calls by concrete type and method. The calls on
+    /// one object keep the order they were recorded in: the first command of every object runs
+    /// (grouped), then the second command of every object, and so on.
+    ///     DynTrt::CommandBuffer commands;
+    ///     commands.Record<Shape::Move>( shape, 0.5, 0.25 );
+    ///     commands.Flush();
+    /// Handles may change after recording but the objects must live until Flush or Clear.
+    class CommandBuffer
+    {
+    public:
+        static constexpr std::size_t default_chunk_size = 16 * 1024;
+
+        explicit CommandBuffer( std::size_t chunk_size = default_chunk_size ): chunk_size(chunk_size) {}
+
+        CommandBuffer( const CommandBuffer& ) = delete;
+        CommandBuffer& operator=( const CommandBuffer& ) = delete;
+
+        ~CommandBuffer() { Clear(); }
+
+        /// Records handle.Call<TyMethod>(args...), args are decayed and stored by value.
+        /// Non-const methods can't be recorded through a const handle.
+        template<typename TyMethod, typename TyHandle, typename... Ts>
+        requires ( 
+            TyMethod::template callable_with<Ts...> && 
+            ( TyMethod::is_const || ! std::is_const_v<TyHandle> ) && 
+            requires( TyHandle& handle ) { handle.pointer; handle.Identity(); handle.template Function<TyMethod>(); }
+        )
+        void Record( TyHandle& handle, Ts&&... args )
+        {
+            RecordFor<TyMethod>( handle, typename TyMethod::arguments{}, std::forward<Ts>(args)... );
+        }
+
+        /// Runs every recorded command and empties the buffer. If a call throws the commands
+        /// not yet run are dropped and the exception is rethrown.
+        /// Commands may record more commands, they run on the next Flush.
+        void Flush()
+        {
+            std::vector<std::uint32_t> order = std::move(spare_order);
+            order.reserve( entries.size() );
+            std::vector<Entry> flushing = std::exchange( entries, std::move(spare_entries) );
+            Order( flushing, order );
+
+            // Hands the vectors back for the next Flush. The arena is kept while a Flush is
+            // running, the commands being replayed live in it.
+            struct Finish
+            {
+                CommandBuffer& buffer;
+                std::vector<Entry>& flushing;
+                std::vector<std::uint32_t>& order;
+                ~Finish()
+                {
+                    flushing.clear();
+                    order.clear();
+                    buffer.spare_entries = std::move(flushing);
+                    buffer.spare_order = std::move(order);
+                    buffer.depth--;
+                    buffer.Reset();
+                }
+            } finish{ *this, flushing, order };
+            depth++;
+
+            std::size_t i = 0;
+            try
+            {
+                for ( ; i < order.size(); i++ )
+                {
+                    Command& command = *flushing[order[i]].command;
+                    command.replay( command, true );
+                }
+            }
+            catch ( ... )
+            {
+                for ( i++; i < order.size(); i++ )
+                {
+                    Command& command = *flushing[order[i]].command;
+                    command.replay( command, false );
+                }
+                throw;
+            }
+        }
+
+        /// Drops every recorded command without running it.
+        void Clear()
+        {
+            for ( Entry& entry : entries )
+                entry.command->replay( *entry.command, false );
+            entries.clear();
+            Reset();
+        }
+
+        std::size_t Size() const { return entries.size(); }
+        bool Empty() const { return entries.empty(); }
+
+    private:
+        struct Command
+        {
+            // Calls (if run) and destroys the arguments.
+            void (*replay)( Command&, bool run );
+            void* object;
+        };
+
+        template<typename TyFunction, typename... Args>
+        struct Recorded : Command
+        {
+            TyFunction function;
+            std::tuple<Args...> arguments;
+        };
+
+        struct Entry
+        {
+            Command* command;
+            const void* table;
+            TypeId method;
+            std::uint32_t ordinal;
+        };
+
+        struct Chunk
+        {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        template<typename TyMethod, typename TyHandle, typename... Args, typename... Ts>
+        void RecordFor( TyHandle& handle, detail::type_sequence<Args...>, Ts&&... args )
+        {
+            static_assert( ( (! std::is_lvalue_reference_v<Args> || std::is_const_v<std::remove_reference_t<Args>>) && ... ),
+                "Deferred calls cannot write through non-const reference parameters" );
+
+            using function_type = decltype(handle.template Function<TyMethod>());
+            using recorded_type = Recorded<function_type, std::decay_t<Args>...>;
+
+            // Room for the entry first, so once the arguments are constructed nothing can throw.
+            if ( entries.size() == entries.capacity() )
+                entries.reserve( entries.empty() ? 64 : entries.size() * 2 );
+
+            void* memory = Allocate( sizeof(recorded_type), alignof(recorded_type) );
+            auto* recorded = new (memory) recorded_type{ 
+                { &Replay<recorded_type>, handle.pointer },
+                handle.template Function<TyMethod>(),
+                std::tuple<std::decay_t<Args>...>( std::forward<Ts>(args)... )
+            };
+            entries.push_back( { recorded, handle.Identity(), type_id<TyMethod>, 0 } );
+        }
+
+        template<typename TyRecorded>
+        static void Replay( Command& command, bool run )
+        {
+            TyRecorded& recorded = static_cast<TyRecorded&>(command);
+            struct Destroy
+            {
+                TyRecorded& recorded;
+                ~Destroy() { recorded.~TyRecorded(); }
+            } destroy{ recorded };
+
+            if ( run )
+            {
+                std::apply( [&]( auto&... args ) { recorded.function( recorded.object, std::move(args)... ); }, recorded.arguments );
+            }
+        }
+
+        // Fills order with the replay order: by ordinal (how many earlier commands target the
+        // same object), then vtable, then method, then recording order.
+        static void Order( std::vector<Entry>& entries, std::vector<std::uint32_t>& order )
+        {
+            order.resize( entries.size() );
+            for ( std::uint32_t i = 0; i < order.size(); i++ )
+                order[i] = i;
+
+            std::stable_sort( order.begin(), order.end(), [&]( std::uint32_t a, std::uint32_t b ) {
+                return std::less<>{}( entries[a].command->object, entries[b].command->object );
+            });
+            for ( std::size_t i = 1; i < order.size(); i++ )
+            {
+                Entry& previous = entries[order[i - 1]];
+                Entry& entry = entries[order[i]];
+                entry.ordinal = entry.command->object == previous.command->object ? previous.ordinal + 1 : 0;
+            }
+
+            std::sort( order.begin(), order.end(), [&]( std::uint32_t a, std::uint32_t b ) {
+                const Entry& x = entries[a];
+                const Entry& y = entries[b];
+                if ( x.ordinal != y.ordinal )
+                    return x.ordinal < y.ordinal;
+                if ( x.table != y.table )
+                    return std::less<>{}( x.table, y.table );
+                if ( x.method != y.method )
+                    return std::less<>{}( x.method, y.method );
+                return a < b;
+            });
+        }
+
+        void* Allocate( std::size_t size, std::size_t alignment )
+        {
+            for ( ; current < chunks.size(); current++, offset = 0 )
+            {
+                void* address = chunks[current].data.get() + offset;
+                std::size_t space = chunks[current].size - offset;
+                if ( std::align( alignment, size, address, space ) )
+                {
+                    offset = static_cast<std::byte*>(address) - chunks[current].data.get() + size;
+                    return address;
+                }
+            }
+
+            // Oversized commands get a chunk of their own.
+            const std::size_t bytes = std::max( chunk_size, size + alignment );
+            chunks.push_back( { std::unique_ptr<std::byte[]>(new std::byte[bytes]), bytes } );
+            offset = 0;
+            return Allocate( size, alignment );
+        }
+
+        // Keeps the chunks for the next commands. The arena is only rewound once no command
+        // lives in it: nothing recorded and no Flush running.
+        void Reset()
+        {
+            if ( depth == 0 && entries.empty() )
+            {
+                current = 0;
+                offset = 0;
+            }
+        }
+
+        std::vector<Chunk> chunks;
+        std::size_t chunk_size;
+        std::size_t current = 0;
+        std::size_t offset = 0;
+
+        std::vector<Entry> entries;
+        // Storage of the last Flush, reused by the next one.
+        std::vector<Entry> spare_entries;
+        std::vector<std::uint32_t> spare_order;
+        // Number of Flush calls running, a command may Flush the buffer it was recorded in.
+        std::size_t depth = 0;
+    };
+}
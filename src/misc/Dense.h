@@ -0,0 +1,239 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "DynTrt.h"
+
+#ifndef DYNTRT_MAX_DENSE_TYPES
+    // Types each DenseTrait can register. The tables only grow as types are registered.
+    #define DYNTRT_MAX_DENSE_TYPES 1024
+#endif
+
+namespace DynTrt
+{
+    /// Trait dispatching through method-major tables: every type used with the trait gets a
+    /// small dense id on first use and each method has one contiguous array of function
+    /// pointers indexed by that id. A loop calling one method over many types then reads one
+    /// array rather than a separate static vtable per type. The handle stores a 16 bit id in
+    /// place of a vtable pointer, padded it is the same size as a Trait.
+    ///     using Drawable = DynTrt::DenseTrait<Shape, Draw, SetColour>;
+    template<typename TraitsType, typename... TyMethods>
+    struct DenseTrait
+    {
+    public:
+        using data_pointer = void;
+        using traits_type = detail::policy_traits_t<TraitsType>;
+        using id_type = std::uint16_t;
+
+        static constexpr std::size_t max_types = DYNTRT_MAX_DENSE_TYPES;
+        static_assert( max_types <= std::size_t(1) << 16, "Ids are 16 bits" );
+
+        template<typename TyMethod, typename T>
+        using typed_method_pointer = typename TyMethod::template any_pointer<T>;
+
+        template<typename TyMethod>
+        using method_pointer = typename TyMethod::template any_pointer<data_pointer>;
+
+        /// Table<Method>()[id] is the function for the type registered as id. The arrays are
+        /// sized to the registered types and replaced as more are registered, replaced arrays
+        /// are kept so calls never lock.
+        template<typename TyMethod>
+        static const method_pointer<TyMethod>* Table()
+        {
+            return tables<TyMethod>.current.load(std::memory_order_acquire);
+        }
+
+    public:
+        ~DenseTrait()=default;
+        DenseTrait( const DenseTrait& )=default;
+        DenseTrait( DenseTrait&& )=default;
+
+        DenseTrait& operator=( const DenseTrait& )=default;
+        DenseTrait& operator=( DenseTrait&& )=default;
+
+        template<typename T>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        DenseTrait( T* value ): pointer(value), id(IdOf<T, false>())
+        {}
+
+        template<typename T>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        DenseTrait( const T* value ): pointer(const_cast<T*>(value)), id(IdOf<T, true>())
+        {}
+
+        /// Dense id of T, registering it on first use. Throws std::length_error when more
+        /// than DYNTRT_MAX_DENSE_TYPES types are used with the trait.
+        template<typename T, bool is_const = false>
+        static id_type IdOf()
+        {
+            static const id_type id = Register<T, is_const>();
+            return id;
+        }
+
+        // Number of types registered so far.
+        static std::size_t Count()
+        {
+            return count.load(std::memory_order_acquire);
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            BoundMethod<TyMethod,TyMethods...> &&
+            ! TyMethod::is_const &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args)
+        {
+            return Table<TyMethod>()[id](pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            TyMethod::is_const &&
+            BoundMethod<TyMethod,TyMethods...> &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            return Table<TyMethod>()[id](pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod>
+        requires ( BoundMethod<TyMethod,TyMethods...> )
+        inline method_pointer<TyMethod> Function() const
+        {
+            return Table<TyMethod>()[id];
+        }
+
+        // Equal for handles to the same concrete type.
+        inline const void* Identity() const
+        {
+            return Type();
+        }
+
+        inline id_type Id() const
+        {
+            return id;
+        }
+
+        inline TypeId Type() const
+        {
+            return types.current.load(std::memory_order_acquire)[id];
+        }
+
+        template<typename T>
+        inline T* Get() 
+        {
+            if ( Type() != type_id<T> )
+                return nullptr;
+
+            return reinterpret_cast<T*>(pointer);
+        }
+
+        template<typename T>
+        inline const T* Get() const
+        {
+            const TypeId type = Type();
+            if ( type != type_id<T> && type != type_id<const T> )
+                return nullptr;
+
+            return reinterpret_cast<const T*>(pointer);
+        }
+
+    private:
+        template<typename TyMethod, typename T, bool is_const>
+        static constexpr method_pointer<TyMethod> Entry()
+        {
+            constexpr method_pointer<TyMethod> function = &TyMethod::template Erased<traits_type, TyMethod, T>;
+            constexpr method_pointer<TyMethod> wrapped = detail::wrap_entry<TraitsType, DenseTrait, TyMethod, std::conditional_t<is_const, const T, T>, function>();
+            return detail::observe_entry<TraitsType, TyMethod, wrapped>();
+        }
+
+        // One array per method (and one of types), grown by doubling. Arrays are only written
+        // under the registry mutex, at indices no handle has yet.
+        template<typename TyEntry>
+        struct Column
+        {
+            std::atomic<TyEntry*> current{ nullptr };
+            std::vector<std::unique_ptr<TyEntry[]>> arrays;
+
+            void Grow( std::size_t used, std::size_t size )
+            {
+                std::unique_ptr<TyEntry[]> grown = std::make_unique<TyEntry[]>(size);
+                TyEntry* previous = current.load(std::memory_order_relaxed);
+                std::copy( previous, previous + used, grown.get() );
+                arrays.push_back( std::move(grown) );
+                current.store( arrays.back().get(), std::memory_order_release );
+            }
+        };
+
+        template<typename T, bool is_const>
+        static id_type Register()
+        {
+            std::lock_guard lock{ registry_mutex };
+            const std::size_t next = count.load(std::memory_order_relaxed);
+            if ( next >= max_types )
+                throw std::length_error("DenseTrait: too many types, see DYNTRT_MAX_DENSE_TYPES");
+
+            if ( next == allocated )
+            {
+                const std::size_t size = std::min<std::size_t>( next ? next * 2 : 16, max_types );
+                ( tables<TyMethods>.arrays.reserve( tables<TyMethods>.arrays.size() + 1 ), ... );
+                types.arrays.reserve( types.arrays.size() + 1 );
+
+                ( tables<TyMethods>.Grow( next, size ), ... );
+                types.Grow( next, size );
+                allocated = size;
+            }
+
+            ((tables<TyMethods>.current.load(std::memory_order_relaxed)[next] = Entry<TyMethods, T, is_const>()), ...);
+            types.current.load(std::memory_order_relaxed)[next] = type_id<std::conditional_t<is_const, const T, T>>;
+            count.store( next + 1, std::memory_order_release );
+            return static_cast<id_type>(next);
+        }
+
+        template<typename TyMethod>
+        static inline Column<method_pointer<TyMethod>> tables;
+
+        static inline Column<TypeId> types;
+        static inline std::mutex registry_mutex;
+        static inline std::size_t allocated = 0;
+        static inline std::atomic<std::size_t> count{ 0 };
+
+    public:
+        void* pointer = nullptr;
+        id_type id = 0;
+    };
+}
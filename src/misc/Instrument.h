@@ -0,0 +1,233 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    namespace detail
+    {
+        struct CallCounter;
+
+        struct CallRegistry
+        {
+            std::mutex mutex;
+            std::vector<CallCounter*> counters;
+        };
+
+        inline CallRegistry& call_registry()
+        {
+            static CallRegistry registry;
+            return registry;
+        }
+
+        // One per (trait, method, type) vtable entry, registered when the entry is first instantiated.
+        struct CallCounter
+        {
+            CallCounter( std::string_view trait, std::string_view method, std::string_view type ):
+                trait(trait), method(method), type(type)
+            {
+                CallRegistry& registry = call_registry();
+                std::lock_guard lock{ registry.mutex };
+                registry.counters.push_back(this);
+            }
+
+            std::string_view trait;
+            std::string_view method;
+            std::string_view type;
+            std::atomic<std::uint64_t> calls{ 0 };
+            std::atomic<std::uint64_t> samples{ 0 };
+            std::atomic<std::uint64_t> sampled_ns{ 0 };
+        };
+
+        struct SampleScope
+        {
+            explicit SampleScope( CallCounter& counter ): counter(counter), start(std::chrono::steady_clock::now()) {}
+
+            ~SampleScope()
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                counter.sampled_ns.fetch_add( std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed );
+                counter.samples.fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            CallCounter& counter;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        template<std::size_t SamplePeriod, typename TyTrait, typename TyMethod, typename T, auto Function, typename = decltype(Function)>
+        struct InstrumentedThunk;
+
+        template<std::size_t SamplePeriod, typename TyTrait, typename TyMethod, typename T, auto Function, typename Ret, typename U, typename... Args>
+        struct InstrumentedThunk<SamplePeriod, TyTrait, TyMethod, T, Function, Ret(*)(U*, Args...)>
+        {
+            static inline CallCounter counter{ type_name<TyTrait>(), type_name<TyMethod>(), type_name<T>() };
+
+            static Ret Invk( U* self, Args... args )
+            {
+                const std::uint64_t call = counter.calls.fetch_add( 1, std::memory_order_relaxed );
+                if constexpr ( SamplePeriod > 0 )
+                {
+                    if ( call % SamplePeriod == 0 )
+                    {
+                        SampleScope scope{ counter };
+                        return Function(self, std::forward<Args>(args)...);
+                    }
+                }
+                return Function(self, std::forward<Args>(args)...);
+            }
+        };
+    }
+
+    /// Policy option counting calls per (trait, method, concrete type). Every 
+    /// SamplePeriod-th call of an entry is also timed, 0 disables timing.
+    /// The vtable entries are wrapped so traits without the option are untouched.
+    ///     using Drawable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Instrument<64>>, Draw>;
+    ///
+    /// AnyValue shares its vtables with the matching Trait, so its calls are counted against it.
+    template<std::size_t SamplePeriod = 0>
+    struct Instrument
+    {
+        using thunk_option = void;
+
+        template<typename TyTrait, typename TyMethod, typename T, auto Function>
+        static constexpr auto thunk = &detail::InstrumentedThunk<SamplePeriod, TyTrait, TyMethod, T, Function>::Invk;
+    };
+
+    namespace Instrumentation
+    {
+        struct CallStats
+        {
+            std::string_view trait;
+            std::string_view method;
+            std::string_view type;
+            std::uint64_t calls = 0;
+            std::uint64_t samples = 0;
+            std::uint64_t sampled_ns = 0;
+
+            // Mean latency of the sampled calls, 0 if none were sampled.
+            double MeanNs() const { return samples ? double(sampled_ns) / double(samples) : 0.0; }
+        };
+
+        /// Current counts of every instrumented entry, most called first. Counts are
+        /// read without stopping callers so a snapshot taken under load is approximate.
+        inline std::vector<CallStats> Snapshot()
+        {
+            detail::CallRegistry& registry = detail::call_registry();
+            std::vector<CallStats> stats;
+            {
+                std::lock_guard lock{ registry.mutex };
+                stats.reserve( registry.counters.size() );
+                for ( const detail::CallCounter* counter : registry.counters )
+                {
+                    stats.push_back({
+                        counter->trait, counter->method, counter->type,
+                        counter->calls.load(std::memory_order_relaxed),
+                        counter->samples.load(std::memory_order_relaxed),
+                        counter->sampled_ns.load(std::memory_order_relaxed)
+                    });
+                }
+            }
+
+            std::stable_sort( stats.begin(), stats.end(), []( const CallStats& a, const CallStats& b ) {
+                return a.calls > b.calls;
+            });
+            return stats;
+        }
+
+        inline void Reset()
+        {
+            detail::CallRegistry& registry = detail::call_registry();
+            std::lock_guard lock{ registry.mutex };
+            for ( detail::CallCounter* counter : registry.counters )
+            {
+                counter->calls.store( 0, std::memory_order_relaxed );
+                counter->samples.store( 0, std::memory_order_relaxed );
+                counter->sampled_ns.store( 0, std::memory_order_relaxed );
+            }
+        }
+
+        /// One line per entry: calls, mean sampled ns, method, type and trait.
+        inline std::string Text( const std::vector<CallStats>& stats )
+        {
+            std::string text;
+            char buffer[64];
+            for ( const CallStats& entry : stats )
+            {
+                std::snprintf( buffer, sizeof(buffer), "%12llu %10.1f ", (unsigned long long)entry.calls, entry.MeanNs() );
+                text += buffer;
+                text += entry.method;
+                text += ' ';
+                text += entry.type;
+                text += ' ';
+                text += entry.trait;
+                text += '\n';
+            }
+            return text;
+        }
+
+        inline std::string Json( const std::vector<CallStats>& stats )
+        {
+            auto quoted = []( std::string& out, std::string_view text ) {
+                out += '"';
+                for ( char c : text )
+                {
+                    if ( c == '"' || c == '\\' )
+                        out += '\\';
+                    out += c;
+                }
+                out += '"';
+            };
+
+            std::string json = "[";
+            char buffer[96];
+            for ( std::size_t i = 0; i < stats.size(); i++ )
+            {
+                const CallStats& entry = stats[i];
+                json += i ? ",\n {" : "\n {";
+                json += "\"trait\": ";
+                quoted( json, entry.trait );
+                json += ", \"method\": ";
+                quoted( json, entry.method );
+                json += ", \"type\": ";
+                quoted( json, entry.type );
+                std::snprintf( buffer, sizeof(buffer), ", \"calls\": %llu, \"samples\": %llu, \"sampled_ns\": %llu}",
+                    (unsigned long long)entry.calls, (unsigned long long)entry.samples, (unsigned long long)entry.sampled_ns );
+                json += buffer;
+            }
+            json += stats.empty() ? "]" : "\n]";
+            return json;
+        }
+    }
+}
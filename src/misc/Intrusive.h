@@ -0,0 +1,194 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    /// Vtable pointer stored in the object itself, see Intrusive.
+    template<typename TyTrait>
+    struct TraitHeader
+    {
+        const void* table;
+    };
+
+    /// Base for types that carry their own vtable pointer so they can be used through an 8 byte
+    /// ThinTrait. T is the deriving type and Intrusive must be its first base, the header is
+    /// expected at the start of the object. The table is the same one Trait uses for T.
+    ///     struct Circle : DynTrt::Intrusive<Shape::Drawable, Circle> { ... };
+    template<typename TyTrait, typename T>
+    struct Intrusive : TraitHeader<TyTrait>
+    {
+        constexpr Intrusive(): TraitHeader<TyTrait>{ &TyTrait::template StaticTable<T, false>() } {}
+    };
+
+    /// Single pointer handle to an object deriving from Intrusive<TyTrait, T>. Calls load the
+    /// vtable from the object header instead of the handle, otherwise it behaves like TyTrait.
+    /// Handles made from a const T* report const T as their Type() and only give out const T*.
+    /// Calling a non-const method through one throws std::logic_error.
+    template<typename TyTrait>
+    struct ThinTrait;
+
+    template<typename TraitsType, typename... TyMethods>
+    struct ThinTrait<Trait<TraitsType, TyMethods...>>
+    {
+    public:
+        using trait_type = Trait<TraitsType, TyMethods...>;
+        using header_type = TraitHeader<trait_type>;
+        using vtable = typename trait_type::template vtable<void>;
+
+        template<typename TyMethod>
+        using method_pointer = typename trait_type::template method_pointer<TyMethod>;
+
+        ThinTrait( const ThinTrait& )=default;
+        ThinTrait( ThinTrait&& )=default;
+
+        ThinTrait& operator=( const ThinTrait& )=default;
+        ThinTrait& operator=( ThinTrait&& )=default;
+
+        template<typename T>
+        requires( std::derived_from<T, header_type> )
+        ThinTrait( T* value ): bits(reinterpret_cast<std::uintptr_t>(value))
+        {
+            assert( static_cast<const void*>(static_cast<const header_type*>(value)) == static_cast<const void*>(value) );
+        }
+
+        template<typename T>
+        requires( std::derived_from<T, header_type> )
+        ThinTrait( const T* value ): bits(reinterpret_cast<std::uintptr_t>(value) | const_bit)
+        {
+            assert( static_cast<const void*>(static_cast<const header_type*>(value)) == static_cast<const void*>(value) );
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            BoundMethod<TyMethod,TyMethods...> &&
+            ! TyMethod::is_const &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args)
+        {
+            if ( bits & const_bit )
+                throw std::logic_error( "ThinTrait: non-const method called through a handle made from a const pointer" );
+
+            return Function<TyMethod>()(Pointer(), std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            TyMethod::is_const &&
+            BoundMethod<TyMethod,TyMethods...> &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            return Function<TyMethod>()(Pointer(), std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod>
+        requires ( BoundMethod<TyMethod,TyMethods...> )
+        inline method_pointer<TyMethod> Function() const
+        {
+            constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
+            return detail::get<n>(Table());
+        }
+
+        // Equal for handles to the same concrete type, and the same as the Identity of Wide().
+        inline const void* Identity() const
+        {
+            return &QualifiedTable();
+        }
+
+        inline TypeId Type() const
+        {
+            return detail::get<typename trait_type::TypeInfo>(QualifiedTable()).type;
+        }
+
+        template<typename T>
+        inline T* Get()
+        {
+            if ( Type() != type_id<T> )
+                return nullptr;
+
+            return static_cast<T*>(Pointer());
+        }
+
+        template<typename T>
+        inline const T* Get() const
+        {
+            const TypeId type = Type();
+            if ( type != type_id<T> && type != type_id<const T> )
+                return nullptr;
+
+            return static_cast<const T*>(Pointer());
+        }
+
+        /// Wide handle to the same object, for code taking the Trait. Handles made from a
+        /// const T* give the same handle as a Trait made from one.
+        inline trait_type Wide()
+        {
+            return std::as_const(*this).Wide();
+        }
+
+        inline const trait_type Wide() const
+        {
+            return trait_type::FromTable(QualifiedTable(), Pointer());
+        }
+
+    private:
+        static constexpr std::uintptr_t const_bit = 1;
+        static_assert( alignof(header_type) > const_bit );
+
+        inline void* Pointer() const
+        {
+            return reinterpret_cast<void*>(bits & ~const_bit);
+        }
+
+        inline const header_type* Header() const
+        {
+            return static_cast<const header_type*>(Pointer());
+        }
+
+        inline const vtable& Table() const
+        {
+            return *static_cast<const vtable*>(Header()->table);
+        }
+
+        // The table a Trait made from the same pointer would have, only read off the call path.
+        inline const vtable& QualifiedTable() const
+        {
+            if ( bits & const_bit )
+                return trait_type::ConstTable(Table());
+
+            return Table();
+        }
+
+        std::uintptr_t bits;
+    };
+}
@@ -0,0 +1,195 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    namespace detail
+    {
+        inline std::size_t hash_combine( std::size_t seed, std::size_t value )
+        {
+            return seed ^ ( value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2) );
+        }
+
+        // Fibonacci hash of an address into one of Slots (a power of two) version counters.
+        template<std::size_t Slots>
+        std::size_t memo_slot( const void* object )
+        {
+            constexpr int shift = 64 - std::countr_zero(Slots);
+            return static_cast<std::size_t>( ( std::uint64_t(reinterpret_cast<std::uintptr_t>(object)) * 0x9e3779b97f4a7c15ull ) >> shift );
+        }
+
+        template<typename TyObservers, typename T>
+        inline constexpr bool has_observer = false;
+
+        template<typename... TyObservers, typename T>
+        inline constexpr bool has_observer<type_sequence<TyObservers...>, T> = ( std::same_as<TyObservers, T> || ... );
+
+        template<typename T>
+        concept hashable = requires( const T& value ) { { std::hash<T>{}(value) } -> std::convertible_to<std::size_t>; };
+
+        template<typename TraitsType, typename TyMethod, std::size_t Capacity, typename TyArguments>
+        struct MemoSignature;
+
+        template<typename TraitsType, typename TyMethod, std::size_t Capacity, typename... Args>
+        struct MemoSignature<TraitsType, TyMethod, Capacity, type_sequence<Args...>> : 
+            Signature<typename TyMethod::return_type(const void*, Args...)>
+        {
+            using return_type = typename TyMethod::return_type;
+            using traits_type = policy_traits_t<TraitsType>;
+            using key_type = std::tuple<std::decay_t<Args>...>;
+
+            static_assert( ( hashable<std::decay_t<Args>> && ... ), "MemoMethod arguments need a std::hash specialisation" );
+
+            struct Cached
+            {
+                TypeId type;
+                const void* object;
+                std::uint32_t version;
+                key_type arguments;
+                return_type result;
+            };
+
+            // Objects hash to one of these counters, bumped on every mutation of an object with
+            // that hash. Cached results remember the counter they were made under.
+            static constexpr std::size_t version_slots = std::bit_ceil(Capacity) * 16;
+            static inline std::atomic<std::uint32_t> versions[version_slots]{};
+
+            static inline std::atomic<std::uint64_t> hits{ 0 };
+            static inline std::atomic<std::uint64_t> misses{ 0 };
+
+            static std::atomic<std::uint32_t>& Version( const void* object )
+            {
+                return versions[memo_slot<version_slots>(object)];
+            }
+
+            // Each thread has its own direct mapped cache of Capacity results for this method,
+            // shared by every type, so a new result replaces whichever one shared its slot.
+            static std::vector<std::optional<Cached>>& Cache()
+            {
+                thread_local std::vector<std::optional<Cached>> cache( Capacity );
+                return cache;
+            }
+
+            // Called by Signature::Erased.
+            template<typename Trait, typename TyMemo, typename T>
+            static return_type Invk( const T* value, Args... args )
+            {
+                static_assert( has_observer<traits_observers_t<TraitsType>, TyMemo>, 
+                    "MemoMethod must be listed in its Traits struct: using mutation_observers = DynTrt::Observers<...>" );
+
+                std::size_t hash = std::hash<const void*>{}(value);
+                hash = hash_combine( hash, std::hash<TypeId>{}(type_id<T>) );
+                ( ( hash = hash_combine( hash, std::hash<std::decay_t<Args>>{}(args) ) ), ... );
+
+                const std::uint32_t version = Version(value).load( std::memory_order_acquire );
+                std::optional<Cached>& cached = Cache()[hash % Capacity];
+                if ( cached && cached->object == value && cached->type == type_id<T> && 
+                    cached->version == version && cached->arguments == std::tie(args...) )
+                {
+                    hits.fetch_add( 1, std::memory_order_relaxed );
+                    return cached->result;
+                }
+
+                misses.fetch_add( 1, std::memory_order_relaxed );
+                return_type result = TyMethod::template Invk<Trait, TyMethod>(value, args...);
+                cached.reset();
+                cached.emplace( Cached{ type_id<T>, value, version, key_type(args...), result } );
+                return result;
+            }
+
+            // Only used unevaluated (see HasOverload), a type has the memo method if it has the uncached one.
+            template<typename Trait, typename Ty, typename>
+            requires( HasOverload<Trait, Ty, TyMethod> )
+            static return_type DummyInvoke();
+        };
+    }
+
+    struct MemoStats
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+
+        // Fraction of calls answered from the cache, 0 if there were none.
+        double HitRate() const { return hits + misses ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    /// Caching flavour of the pure const method TyMethod. Results are kept per object and
+    /// arguments, and are dropped when a non-const method is called on the object through any
+    /// vtable of TraitsType, which must list its memo methods as mutation observers:
+    ///     struct Shape {
+    ///         ...
+    ///         using Bounds = DynTrt::MemoMethod<Shape, BoundingBox>;
+    ///         using mutation_observers = DynTrt::Observers<Bounds>;
+    ///     };
+    ///     using Bounded = DynTrt::Trait<Shape, Bounds, Move>;
+    ///     box = bounded.Call<Shape::Bounds>();   // calls BoundingBox once until the next Move
+    /// Each thread keeps Capacity results of this method, arguments must be hashable and
+    /// equality comparable. Objects share Capacity * 16 version counters, so a mutation may
+    /// also drop the results of an unrelated object. Mutations made any other way (direct
+    /// calls, ClosedTrait, PolyColumns...) must be followed by Invalidate(object), as must
+    /// destroying an object whose memory may be reused by a new one.
+    template<typename TraitsType, typename TyMethod, std::size_t Capacity = 256>
+    requires( 
+        TyMethod::is_const && Capacity > 0 &&
+        ! std::is_void_v<typename TyMethod::return_type> &&
+        ! std::is_reference_v<typename TyMethod::return_type>
+    )
+    struct MemoMethod : detail::MemoSignature<TraitsType, TyMethod, Capacity, typename TyMethod::arguments>
+    {
+        using uncached_method = TyMethod;
+
+        /// Drops the results of this method for object (and for objects that share its version counter).
+        static void Mutated( const void* object )
+        {
+            MemoMethod::Version(object).fetch_add( 1, std::memory_order_release );
+        }
+
+        static void Invalidate( const void* object )
+        {
+            Mutated(object);
+        }
+
+        /// Calls of this method over every thread since the last ResetStats.
+        static MemoStats Stats()
+        {
+            return { MemoMethod::hits.load(std::memory_order_relaxed), MemoMethod::misses.load(std::memory_order_relaxed) };
+        }
+
+        static void ResetStats()
+        {
+            MemoMethod::hits.store( 0, std::memory_order_relaxed );
+            MemoMethod::misses.store( 0, std::memory_order_relaxed );
+        }
+    };
+}
@@ -0,0 +1,157 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+#include "DynTrt.h"
+
+namespace DynTrt
+{
+    /// Option for MultiMethod: a pair with no registered function falls back to the pair with
+    /// the arguments swapped, so Collide(a, b) only needs registering one way round.
+    struct Symmetric {};
+
+    /// Method over two objects, dispatched on both of their types:
+    ///     struct Collide : DynTrt::MultiMethod<bool(DynTrt::ConstSelf, DynTrt::ConstSelf), DynTrt::Symmetric> {};
+    ///
+    ///     template<> bool Shape::Invoke<Shape::Collide>( const Circle* a, const Rectangle* b ) { ... }
+    ///     DynTrt::RegisterPair<Shape, Shape::Collide, Circle, Rectangle>();
+    ///     bool hit = DynTrt::MultiCall<Shape::Collide>( circle, rectangle );
+    template<typename TyFunction, typename... TyOptions>
+    struct MultiMethod;
+
+    template<typename Ret, typename A, typename B, typename... Args, typename... TyOptions>
+    requires( 
+        ( std::same_as<A, void*> || std::same_as<A, const void*> ) &&
+        ( std::same_as<B, void*> || std::same_as<B, const void*> )
+    )
+    struct MultiMethod<Ret(A, B, Args...), TyOptions...>
+    {
+        using return_type = Ret;
+        using function_pointer = Ret(*)(A, B, Args...);
+
+        static constexpr bool first_const = std::is_const_v<std::remove_pointer_t<A>>;
+        static constexpr bool second_const = std::is_const_v<std::remove_pointer_t<B>>;
+        static constexpr bool symmetric = ( std::same_as<TyOptions, Symmetric> || ... );
+        static_assert( ! symmetric || std::same_as<A, B>, "Symmetric multimethods need both selves alike" );
+
+        template<typename... Ts>
+        static constexpr bool callable_with = std::is_invocable_v<Ret(*)(Args...), Ts...>;
+
+        template<typename Traits, typename TyMethod, typename T, typename U>
+        static Ret Invk( A a, B b, Args... args )
+        {
+            using first = std::conditional_t<first_const, const T, T>;
+            using second = std::conditional_t<second_const, const U, U>;
+            return Traits::template Invoke<TyMethod>(static_cast<first*>(a), static_cast<second*>(b), std::forward<Args>(args)...);
+        }
+    };
+
+    /// Thrown by MultiCall when no function is registered for the pair of types.
+    struct bad_multimethod_call : std::exception
+    {
+        const char* what() const noexcept override { return "DynTrt: no multimethod registered for these types"; }
+    };
+
+    namespace detail
+    {
+        // Square table of functions indexed by the dense indices of both types.
+        template<typename TyMethod>
+        struct MultiTable
+        {
+            using function_pointer = typename TyMethod::function_pointer;
+
+            void Set( std::uint32_t first, std::uint32_t second, function_pointer function )
+            {
+                std::lock_guard lock{ mutex };
+                const std::size_t needed = std::max( first, second ) + 1;
+                if ( needed > stride )
+                {
+                    const std::size_t grown = std::max( needed, stride * 2 );
+                    std::vector<function_pointer> resized( grown * grown, nullptr );
+                    for ( std::size_t i = 0; i < stride; i++ )
+                        std::copy_n( entries.begin() + i * stride, stride, resized.begin() + i * grown );
+                    entries = std::move(resized);
+                    stride = grown;
+                }
+                entries[first * stride + second] = function;
+            }
+
+            inline function_pointer Get( std::uint32_t first, std::uint32_t second ) const
+            {
+                if ( first >= stride || second >= stride )
+                    return nullptr;
+                return entries[first * stride + second];
+            }
+
+            std::mutex mutex;
+            std::vector<function_pointer> entries;
+            std::size_t stride = 0;
+        };
+
+        template<typename TyMethod>
+        inline MultiTable<TyMethod> multi_table;
+    }
+
+    /// Makes MultiCall<TyMethod> on a (T, U) pair call Traits::Invoke<TyMethod>(T*, U*, ...).
+    /// Register every pair before calling from several threads, the table may be resized here.
+    template<typename Traits, typename TyMethod, typename T, typename U>
+    void RegisterPair()
+    {
+        detail::multi_table<TyMethod>.Set( 
+            detail::type_index<T>(), detail::type_index<U>(),
+            &TyMethod::template Invk<Traits, TyMethod, T, U>
+        );
+    }
+
+    /// Calls TyMethod for the concrete types behind two handles (anything with Type() and
+    /// pointer, such as Trait or DenseTrait), one lookup in a table indexed by both types.
+    template<typename TyMethod, typename TyFirst, typename TySecond, typename... Ts>
+    requires( TyMethod::template callable_with<Ts...> )
+    decltype(auto) MultiCall( TyFirst& first, TySecond& second, Ts&&... args )
+    {
+        static_assert( TyMethod::first_const || ! std::is_const_v<TyFirst>, "First handle is const but the method takes Self" );
+        static_assert( TyMethod::second_const || ! std::is_const_v<TySecond>, "Second handle is const but the method takes Self" );
+
+        const auto& table = detail::multi_table<TyMethod>;
+        const std::uint32_t a = first.Type()->index.load(std::memory_order_acquire);
+        const std::uint32_t b = second.Type()->index.load(std::memory_order_acquire);
+
+        if ( const auto function = table.Get(a, b) )
+            return function(first.pointer, second.pointer, std::forward<Ts>(args)...);
+
+        if constexpr ( TyMethod::symmetric )
+        {
+            if ( const auto function = table.Get(b, a) )
+                return function(second.pointer, first.pointer, std::forward<Ts>(args)...);
+        }
+
+        throw bad_multimethod_call{};
+    }
+}
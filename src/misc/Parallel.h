@@ -0,0 +1,358 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+#include "DynTrt.h"
+#include "Batch.h"
+
+namespace DynTrt
+{
+    /// Small work stealing pool. Each worker owns a queue it pops from the back of and steals
+    /// from the front of the others when empty. The thread calling Run works on the job too,
+    /// so a pool of N threads starts N - 1 workers.
+    class ThreadPool
+    {
+    public:
+        // Half open range of indices handed to one task.
+        struct Range
+        {
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        explicit ThreadPool( std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1) ):
+            queues(std::max<std::size_t>(threads, 2) - 1)
+        {
+            for ( auto& queue : queues )
+                queue = std::make_unique<Queue>();
+
+            for ( std::size_t i = 1; i < threads; i++ )
+                workers.emplace_back( [this, i]() { Work(i - 1); } );
+        }
+
+        ThreadPool( const ThreadPool& )=delete;
+        ThreadPool& operator=( const ThreadPool& )=delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard lock{ sleep_mutex };
+                stopping = true;
+            }
+            wake.notify_all();
+            for ( std::thread& worker : workers )
+                worker.join();
+        }
+
+        /// Threads working on a job, including the caller.
+        std::size_t Size() const
+        {
+            return workers.size() + 1;
+        }
+
+        /// Calls f(begin, end) for every range and returns once all have finished. The first
+        /// exception thrown by f is rethrown here after the remaining ranges have run.
+        template<typename F>
+        void Run( std::span<const Range> ranges, F&& f )
+        {
+            if ( ranges.empty() )
+                return;
+
+            if ( workers.empty() )
+            {
+                for ( const Range& range : ranges )
+                    f(range.begin, range.end);
+                return;
+            }
+
+            using function = std::remove_reference_t<F>;
+            Job job;
+            job.context = &f;
+            job.run = []( void* context, std::size_t begin, std::size_t end ) {
+                (*static_cast<function*>(context))(begin, end);
+            };
+            job.remaining.store( ranges.size(), std::memory_order_relaxed );
+
+            // Counted before they are published so taking one never sees the count short.
+            {
+                std::lock_guard lock{ sleep_mutex };
+                queued += ranges.size();
+            }
+
+            for ( std::size_t i = 0; i < ranges.size(); i++ )
+            {
+                Queue& queue = *queues[i % queues.size()];
+                std::lock_guard lock{ queue.mutex };
+                queue.tasks.push_back( { &job, ranges[i].begin, ranges[i].end } );
+            }
+            wake.notify_all();
+
+            // Help until nothing is left to take, then sleep until the last task has finished.
+            Task task;
+            while ( Steal(0, task) )
+                Execute(task);
+
+            {
+                std::unique_lock lock{ job.mutex };
+                job.done.wait( lock, [&job]() { return job.finished; } );
+            }
+
+            if ( job.error )
+                std::rethrow_exception( job.error );
+        }
+
+        /// Pool shared by ParallelCall and ParallelReduce when none is given, one thread per core.
+        static ThreadPool& Default()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+    private:
+        struct Job
+        {
+            void (*run)( void* context, std::size_t begin, std::size_t end );
+            void* context;
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            // Set under mutex by the last task, Run may destroy the job as soon as it sees it.
+            bool finished = false;
+            std::exception_ptr error;
+        };
+
+        struct Task
+        {
+            Job* job;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void Work( std::size_t index )
+        {
+            for ( ;; )
+            {
+                Task task;
+                if ( Pop(index, task) || Steal(index + 1, task) )
+                {
+                    Execute(task);
+                    continue;
+                }
+
+                std::unique_lock lock{ sleep_mutex };
+                wake.wait( lock, [this]() { return stopping || queued != 0; } );
+                if ( stopping && queued == 0 )
+                    return;
+            }
+        }
+
+        bool Pop( std::size_t index, Task& task )
+        {
+            Queue& queue = *queues[index];
+            std::lock_guard lock{ queue.mutex };
+            if ( queue.tasks.empty() )
+                return false;
+
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+            Taken();
+            return true;
+        }
+
+        // Takes the oldest task of any queue, starting at first.
+        bool Steal( std::size_t first, Task& task )
+        {
+            for ( std::size_t i = 0; i < queues.size(); i++ )
+            {
+                Queue& queue = *queues[(first + i) % queues.size()];
+                std::lock_guard lock{ queue.mutex };
+                if ( queue.tasks.empty() )
+                    continue;
+
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+                Taken();
+                return true;
+            }
+            return false;
+        }
+
+        void Taken()
+        {
+            std::lock_guard lock{ sleep_mutex };
+            queued--;
+        }
+
+        static void Execute( const Task& task )
+        {
+            Job& job = *task.job;
+            try
+            {
+                job.run( job.context, task.begin, task.end );
+            }
+            catch ( ... )
+            {
+                std::lock_guard lock{ job.mutex };
+                if ( ! job.error )
+                    job.error = std::current_exception();
+            }
+            if ( job.remaining.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+            {
+                std::lock_guard lock{ job.mutex };
+                job.finished = true;
+                job.done.notify_one();
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        std::size_t queued = 0;
+        bool stopping = false;
+    };
+
+    namespace detail
+    {
+        // Fewest handles given to one task, below this the scheduling costs more than the calls.
+        inline constexpr std::size_t min_parallel_chunk = 1024;
+
+        // Splits handles into tasks of roughly equal size that end on a change of type where
+        // possible, so most tasks are one or a few homogeneous runs.
+        template<typename TyHandle>
+        std::vector<ThreadPool::Range> chunk_runs( std::span<TyHandle> handles, std::size_t threads )
+        {
+            const std::size_t count = handles.size();
+            const std::size_t target = std::max( count / (threads * 4) + 1, min_parallel_chunk );
+
+            std::vector<ThreadPool::Range> ranges;
+            std::size_t begin = 0;
+            while ( begin < count )
+            {
+                std::size_t end = std::min( begin + target, count );
+                // Move back to the start of the run containing end, unless the chunk is one run.
+                std::size_t run_start = end;
+                while ( run_start > begin && run_start < count && handles[run_start - 1].Identity() == handles[run_start].Identity() )
+                    run_start--;
+                if ( run_start > begin )
+                    end = run_start;
+
+                ranges.push_back( { begin, end } );
+                begin = end;
+            }
+            return ranges;
+        }
+    }
+
+    /// BatchCall split over the threads of pool. Calls on different handles may run concurrently
+    /// so they must not touch the same object, and args are shared by every thread.
+    template<typename TyMethod, std::ranges::contiguous_range TyRange, typename... Ts>
+    requires (
+        TyMethod::template callable_with<Ts&...> &&
+        ( TyMethod::is_const || ! std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<TyRange>>> )
+    )
+    inline void ParallelCall( ThreadPool& pool, TyRange&& range, Ts&&... args )
+    {
+        std::span handles{range};
+        const auto ranges = detail::chunk_runs( handles, pool.Size() );
+        pool.Run( ranges, [&]( std::size_t begin, std::size_t end ) {
+            BatchCall<TyMethod>( handles.subspan(begin, end - begin), args... );
+        });
+    }
+
+    template<typename TyMethod, std::ranges::contiguous_range TyRange, typename... Ts>
+    requires (
+        TyMethod::template callable_with<Ts&...> &&
+        ( TyMethod::is_const || ! std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<TyRange>>> )
+    )
+    inline void ParallelCall( TyRange&& range, Ts&&... args )
+    {
+        ParallelCall<TyMethod>( ThreadPool::Default(), std::forward<TyRange>(range), std::forward<Ts>(args)... );
+    }
+
+    /// Calls TyMethod on every handle and folds the results with combine. Like std::reduce
+    /// init must be an identity of combine: it starts every task. Partial results are combined
+    /// in order so the result does not depend on scheduling.
+    ///     Colour mixed = DynTrt::ParallelReduce<Shape::Draw>( shapes, Colour{}, Mix );
+    template<typename TyMethod, std::ranges::contiguous_range TyRange, typename TyResult, typename TyCombine, typename... Ts>
+    requires (
+        TyMethod::template callable_with<Ts&...> &&
+        ( TyMethod::is_const || ! std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<TyRange>>> )
+    )
+    inline TyResult ParallelReduce( ThreadPool& pool, TyRange&& range, TyResult init, TyCombine combine, Ts&&... args )
+    {
+        std::span handles{range};
+        const auto ranges = detail::chunk_runs( handles, pool.Size() );
+        std::vector<TyResult> partials( ranges.size(), init );
+
+        pool.Run( ranges, [&]( std::size_t begin, std::size_t end ) {
+            const std::size_t task = std::lower_bound( ranges.begin(), ranges.end(), begin, []( const auto& r, std::size_t b ) { 
+                return r.begin < b; 
+            }) - ranges.begin();
+
+            TyResult result = init;
+            std::size_t i = begin;
+            while ( i < end )
+            {
+                const void* identity = handles[i].Identity();
+                const auto function = handles[i].template Function<TyMethod>();
+                for ( ; i < end && handles[i].Identity() == identity; i++ )
+                    result = combine( std::move(result), function( handles[i].pointer, args... ) );
+            }
+            partials[task] = std::move(result);
+        });
+
+        TyResult result = std::move(init);
+        for ( TyResult& partial : partials )
+            result = combine( std::move(result), std::move(partial) );
+        return result;
+    }
+
+    template<typename TyMethod, std::ranges::contiguous_range TyRange, typename TyResult, typename TyCombine, typename... Ts>
+    requires (
+        TyMethod::template callable_with<Ts&...> &&
+        ( TyMethod::is_const || ! std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<TyRange>>> )
+    )
+    inline TyResult ParallelReduce( TyRange&& range, TyResult init, TyCombine combine, Ts&&... args )
+    {
+        return ParallelReduce<TyMethod>( ThreadPool::Default(), std::forward<TyRange>(range), std::move(init), std::move(combine), std::forward<Ts>(args)... );
+    }
+}
@@ -0,0 +1,209 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include "DynTrt.h"
+
+#if defined(_WIN32)
+    #define DYNTRT_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+    #define DYNTRT_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace DynTrt
+{
+    /// Bumped whenever PluginHeader or the table layout changes.
+    inline constexpr std::uint32_t plugin_abi_version = 1;
+
+    namespace detail
+    {
+        // stable_name<T> with a terminating null for PluginHeader::type_name.
+        template<typename T>
+        inline constexpr auto stable_name_chars = []() {
+            std::array<char, stable_name<T>.size() + 1> chars{};
+            for ( std::size_t i = 0; i < stable_name<T>.size(); i++ )
+                chars[i] = stable_name<T>[i];
+            return chars;
+        }();
+    }
+
+    /// Start of every exported table. C layout so plugins built by other toolchains (or in C) can
+    /// provide tables too:
+    ///     struct PluginHeader { uint32_t abi; uint32_t method_count; uint64_t signature; uint64_t type; const char* type_name; };
+    ///     struct ShapeTable { struct PluginHeader header; void (*functions[N])(void); };
+    struct PluginHeader
+    {
+        std::uint32_t abi;
+        std::uint32_t method_count;
+        // Hash of the Traits struct and the signature of every method, in order.
+        std::uint64_t signature;
+        std::uint64_t type;
+        const char* type_name;
+    };
+
+    using PluginFunction = void(*)();
+
+    template<std::size_t N>
+    struct PluginTable
+    {
+        PluginHeader header;
+        PluginFunction functions[N];
+    };
+
+    /// Handle whose vtable may come from another shared object. The table is a PluginTable
+    /// holding each method's entry with no wrapper, so a call is a load and an indirect call
+    /// like Trait. Types are compared by stable_type_id rather than by address.
+    /// A plugin exports the table for each of its types once:
+    ///     using Shapes = DynTrt::PluginTrait<Shape::Scalable>;
+    ///     DYNTRT_PLUGIN_EXPORT const void* circle_table() { return &Shapes::Export<Circle>(); }
+    /// and the host checks it once when loading, then wraps objects from the plugin around it:
+    ///     const Shapes::vtable* table = Shapes::Accept( circle_table() );
+    ///     Shapes shape{ *table, object };
+    /// Policy options (Instrument) and MemoMethod invalidation do not apply to plugin tables.
+    template<typename TyTrait>
+    struct PluginTrait;
+
+    template<typename TraitsType, typename... TyMethods>
+    struct PluginTrait<Trait<TraitsType, TyMethods...>>
+    {
+    public:
+        using trait_type = Trait<TraitsType, TyMethods...>;
+        using traits_type = typename trait_type::traits_type;
+        using vtable = PluginTable<sizeof...(TyMethods)>;
+
+        template<typename TyMethod>
+        using method_pointer = typename trait_type::template method_pointer<TyMethod>;
+
+        static constexpr std::uint64_t signature = detail::interface_signature<traits_type, TyMethods...>;
+
+        PluginTrait( const PluginTrait& )=default;
+        PluginTrait( PluginTrait&& )=default;
+
+        PluginTrait& operator=( const PluginTrait& )=default;
+        PluginTrait& operator=( PluginTrait&& )=default;
+
+        /// table must have been returned by Accept (or Export in this shared object).
+        constexpr PluginTrait( const vtable& table, void* pointer ): table(&table), pointer(pointer) {}
+
+        template<typename T>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        PluginTrait( T* value ): PluginTrait( Export<T>(), value ) {}
+
+        /// Table for T, made the first time it is asked for. Plugins return it from an exported
+        /// function, the entries are the same functions Trait stores.
+        template<typename T>
+        requires( 
+            (HasOverload<traits_type, T, TyMethods> && ...)
+        )
+        static const vtable& Export()
+        {
+            static const vtable table{
+                PluginHeader{ plugin_abi_version, sizeof...(TyMethods), signature, stable_type_id<T>, detail::stable_name_chars<T>.data() },
+                { reinterpret_cast<PluginFunction>(&TyMethods::template Erased<traits_type, TyMethods, T>)... }
+            };
+            return table;
+        }
+
+        /// exported as a table for this trait if it was made by a compatible build, otherwise nullptr.
+        static const vtable* Accept( const void* exported )
+        {
+            const vtable* table = static_cast<const vtable*>(exported);
+            if ( ! table || 
+                table->header.abi != plugin_abi_version || 
+                table->header.method_count != sizeof...(TyMethods) || 
+                table->header.signature != signature )
+            {
+                return nullptr;
+            }
+            return table;
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            BoundMethod<TyMethod,TyMethods...> &&
+            ! TyMethod::is_const &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args)
+        {
+            return Function<TyMethod>()(pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod, typename... Ts>
+        requires (
+            TyMethod::is_const &&
+            BoundMethod<TyMethod,TyMethods...> &&
+            TyMethod::template callable_with<Ts...>
+        )
+        inline decltype(auto) Call(Ts&&... args) const
+        {
+            return Function<TyMethod>()(pointer, std::forward<Ts>(args)...);
+        }
+
+        template<typename TyMethod>
+        requires ( BoundMethod<TyMethod,TyMethods...> )
+        inline method_pointer<TyMethod> Function() const
+        {
+            constexpr size_t n = detail::index_in_pack<TyMethod, TyMethods...>::value;
+            return reinterpret_cast<method_pointer<TyMethod>>(table->functions[n]);
+        }
+
+        // Equal for handles sharing a table, a type exported by two shared objects has two.
+        inline const void* Identity() const
+        {
+            return table;
+        }
+
+        inline std::uint64_t Type() const
+        {
+            return table->header.type;
+        }
+
+        inline std::string_view TypeName() const
+        {
+            return table->header.type_name;
+        }
+
+        template<typename T>
+        inline T* Get()
+        {
+            return Type() == stable_type_id<T> ? static_cast<T*>(pointer) : nullptr;
+        }
+
+        template<typename T>
+        inline const T* Get() const
+        {
+            return Type() == stable_type_id<T> ? static_cast<const T*>(pointer) : nullptr;
+        }
+
+    public:
+        const vtable* table;
+        void* pointer;
+    };
+}
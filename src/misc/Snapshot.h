@@ -0,0 +1,362 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "DynTrt.h"
+#include "Any.h"
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace DynTrt
+{
+    namespace detail
+    {
+        inline constexpr char snapshot_magic[8] = { 'D', 'Y', 'N', 'T', 'R', 'T', 'S', '\0' };
+        inline constexpr std::uint32_t snapshot_version = 1;
+        inline constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+
+        // Values start at a multiple of this so they are aligned in the mapping.
+        inline constexpr std::uint64_t snapshot_value_alignment = 64;
+
+        struct SnapshotHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t pointer_size;
+            std::uint32_t storage_size;
+            std::uint64_t signature;
+            std::uint64_t value_size;
+            std::uint64_t type_count;
+            std::uint64_t count;
+            std::uint64_t values_offset;
+        };
+
+        // One per registered type, a value's type is stored as its index in this table.
+        struct SnapshotType
+        {
+            std::uint64_t id;
+            std::uint64_t size;
+        };
+
+        // A file mapped copy on write: changes stay in this process and never reach the file.
+        class MappedFile
+        {
+        public:
+            explicit MappedFile( const char* path )
+            {
+#if defined(_WIN32)
+                HANDLE file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+                if ( file == INVALID_HANDLE_VALUE )
+                    throw std::runtime_error( std::string("Could not open snapshot ") + path );
+
+                LARGE_INTEGER file_size{};
+                GetFileSizeEx( file, &file_size );
+                size = static_cast<std::size_t>(file_size.QuadPart);
+
+                HANDLE mapping = size ? CreateFileMappingA( file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr ) : nullptr;
+                CloseHandle( file );
+                if ( mapping )
+                {
+                    data = static_cast<std::byte*>(MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 ));
+                    CloseHandle( mapping );
+                }
+#else
+                const int file = open( path, O_RDONLY );
+                if ( file < 0 )
+                    throw std::runtime_error( std::string("Could not open snapshot ") + path );
+
+                struct stat status{};
+                fstat( file, &status );
+                size = static_cast<std::size_t>(status.st_size);
+
+                int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+                // Every page is written by the fix up pass, so fault them in up front.
+                flags |= MAP_POPULATE;
+#endif
+                void* address = size ? mmap( nullptr, size, PROT_READ | PROT_WRITE, flags, file, 0 ) : MAP_FAILED;
+                close( file );
+                if ( address != MAP_FAILED )
+                    data = static_cast<std::byte*>(address);
+#endif
+                if ( ! data )
+                    throw std::runtime_error( std::string("Could not map snapshot ") + path );
+            }
+
+            MappedFile( MappedFile&& other ): data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+            MappedFile& operator=( MappedFile&& other )
+            {
+                if ( this != &other )
+                {
+                    Unmap();
+                    data = std::exchange(other.data, nullptr);
+                    size = std::exchange(other.size, 0);
+                }
+                return *this;
+            }
+
+            MappedFile( const MappedFile& )=delete;
+            MappedFile& operator=( const MappedFile& )=delete;
+
+            ~MappedFile() { Unmap(); }
+
+            std::byte* data = nullptr;
+            std::size_t size = 0;
+
+        private:
+            void Unmap()
+            {
+                if ( ! data )
+                    return;
+#if defined(_WIN32)
+                UnmapViewOfFile( data );
+#else
+                munmap( data, size );
+#endif
+                data = nullptr;
+            }
+        };
+    }
+
+    /// File format for arrays of AnySmall values whose stored types are all trivially copyable.
+    /// Values are written as raw blocks, with the vtable and ops pointers replaced by an index
+    /// into a table of stable_type_id (see DynTrt.h). Load maps the file and patches the two
+    /// pointers of each value in one pass, the stored bytes are never copied or parsed:
+    ///     using Shapes = DynTrt::Snapshot<Shape::Small, Circle, Rectangle>;
+    ///     Shapes::Write( "shapes.bin", shapes );
+    ///     Shapes::Mapped loaded = Shapes::Load( "shapes.bin" );
+    ///     for ( Shape::Small& shape : loaded.Values() ) ...
+    /// TyTypes lists every type that may be stored. The loader can list them in another order or
+    /// add new ones, types are matched by stable_name, so specialise it for persisted types.
+    /// Files are only readable by builds with the same pointer size, byte order and trait.
+    template<typename TyValue, typename... TyTypes>
+    struct Snapshot;
+
+    template<std::size_t N, typename TraitsType, typename... TyMethods, typename... TyTypes>
+    struct Snapshot<AnyValue<AnyStorage<N>, TraitsType, TyMethods...>, TyTypes...>
+    {
+        using value_type = AnyValue<AnyStorage<N>, TraitsType, TyMethods...>;
+        using trait_type = typename value_type::trait_type;
+        using traits_type = typename value_type::traits_type;
+        using table_type = typename value_type::table_type;
+
+        static_assert( sizeof...(TyTypes) > 0, "Snapshot needs the types that may be stored" );
+        static_assert( ( Anyable<TyTypes> && ... ), "Only trivially copyable types can be persisted" );
+        static_assert( ( ( sizeof(TyTypes) <= N ) && ... ), "Type too big for the storage" );
+
+        // Stored in the table slot of each value, so it must fit in one.
+        using index_type = std::uintptr_t;
+        static_assert( sizeof(table_type) >= sizeof(index_type) );
+
+        static constexpr std::uint64_t signature = detail::interface_signature<traits_type, TyMethods...>;
+
+        /// Values of a loaded snapshot, valid while this is alive. Changes to them are private
+        /// to the process, the file is not modified.
+        class Mapped
+        {
+        public:
+            std::span<value_type> Values() const { return values; }
+            std::size_t Size() const { return values.size(); }
+
+        private:
+            friend struct Snapshot;
+
+            Mapped( detail::MappedFile&& file, std::span<value_type> values ): file(std::move(file)), values(values) {}
+
+            detail::MappedFile file;
+            std::span<value_type> values;
+        };
+
+        /// Throws std::invalid_argument if a value holds a type not in TyTypes, and
+        /// std::runtime_error if the file can't be written.
+        static void Write( const char* path, std::span<const value_type> values )
+        {
+            // Find the value's index before touching the file.
+            std::vector<index_type> indices( values.size() );
+            index_type last = 0;
+            for ( std::size_t i = 0; i < values.size(); i++ )
+            {
+                const detail::StorageOps* ops = values[i].storage.ops;
+                if ( ops != registered_ops[last] )
+                {
+                    last = 0;
+                    while ( last < sizeof...(TyTypes) && ops != registered_ops[last] )
+                        last++;
+
+                    if ( last == sizeof...(TyTypes) )
+                        throw std::invalid_argument( "Snapshot value holds a type that is not registered" );
+                }
+                indices[i] = last;
+            }
+
+            std::FILE* file = std::fopen( path, "wb" );
+            if ( ! file )
+                throw std::runtime_error( std::string("Could not create snapshot ") + path );
+
+            detail::SnapshotHeader header{};
+            std::memcpy( header.magic, detail::snapshot_magic, sizeof(header.magic) );
+            header.version = detail::snapshot_version;
+            header.byte_order = detail::snapshot_byte_order;
+            header.pointer_size = sizeof(void*);
+            header.storage_size = N;
+            header.signature = signature;
+            header.value_size = sizeof(value_type);
+            header.type_count = sizeof...(TyTypes);
+            header.count = values.size();
+            header.values_offset = ValuesOffset( header.type_count );
+
+            const detail::SnapshotType types[] = { { stable_type_id<TyTypes>, sizeof(TyTypes) }... };
+
+            bool ok = std::fwrite( &header, sizeof(header), 1, file ) == 1;
+            ok = ok && std::fwrite( types, sizeof(types), 1, file ) == 1;
+
+            const std::vector<std::byte> padding( header.values_offset - sizeof(header) - sizeof(types) );
+            ok = ok && std::fwrite( padding.data(), 1, padding.size(), file ) == padding.size();
+
+            // Each value is written as zeros apart from its index and the stored bytes, so
+            // padding and pointers never reach the file.
+            constexpr std::size_t block = 4096;
+            std::vector<std::byte> buffer( block * sizeof(value_type) );
+            for ( std::size_t begin = 0; ok && begin < values.size(); begin += block )
+            {
+                const std::size_t count = std::min( block, values.size() - begin );
+                std::memset( buffer.data(), 0, count * sizeof(value_type) );
+                for ( std::size_t i = 0; i < count; i++ )
+                {
+                    const value_type& value = values[begin + i];
+                    std::byte* out = buffer.data() + i * sizeof(value_type);
+                    std::memcpy( out + Offset(value, &value.table), &indices[begin + i], sizeof(index_type) );
+                    std::memcpy( out + Offset(value, &value.storage.buffer), value.storage.buffer, N );
+                }
+                ok = std::fwrite( buffer.data(), sizeof(value_type), count, file ) == count;
+            }
+
+            ok = std::fclose( file ) == 0 && ok;
+            if ( ! ok )
+                throw std::runtime_error( std::string("Could not write snapshot ") + path );
+        }
+
+        /// Throws std::runtime_error if the file can't be mapped, was written for another trait
+        /// or platform, or holds a type the loader does not know.
+        static Mapped Load( const char* path )
+        {
+            detail::MappedFile file( path );
+
+            detail::SnapshotHeader header;
+            if ( file.size < sizeof(header) )
+                throw std::runtime_error( "Snapshot is truncated" );
+            std::memcpy( &header, file.data, sizeof(header) );
+
+            if ( std::memcmp( header.magic, detail::snapshot_magic, sizeof(header.magic) ) != 0 || header.version != detail::snapshot_version )
+                throw std::runtime_error( "Not a snapshot or unsupported version" );
+
+            if ( header.byte_order != detail::snapshot_byte_order || header.pointer_size != sizeof(void*) )
+                throw std::runtime_error( "Snapshot was written on another platform" );
+
+            if ( header.signature != signature || header.storage_size != N || header.value_size != sizeof(value_type) )
+                throw std::runtime_error( "Snapshot was written for another trait" );
+
+            // Checked in this order so none of the sizes can wrap.
+            if ( header.type_count > ( file.size - sizeof(header) ) / sizeof(detail::SnapshotType) ||
+                header.values_offset != ValuesOffset(header.type_count) ||
+                header.values_offset > file.size ||
+                header.count > ( file.size - header.values_offset ) / sizeof(value_type) )
+            {
+                throw std::runtime_error( "Snapshot is truncated" );
+            }
+
+            // Vtable and ops of each type in the file, by file index.
+            std::vector<table_type> tables( header.type_count );
+            std::vector<const detail::StorageOps*> ops( header.type_count );
+            for ( std::size_t i = 0; i < header.type_count; i++ )
+            {
+                detail::SnapshotType type;
+                std::memcpy( &type, file.data + sizeof(header) + i * sizeof(type), sizeof(type) );
+
+                std::size_t registered = 0;
+                while ( registered < sizeof...(TyTypes) && registered_ids[registered] != type.id )
+                    registered++;
+
+                if ( registered == sizeof...(TyTypes) )
+                    throw std::runtime_error( "Snapshot holds a type that is not registered" );
+                if ( registered_sizes[registered] != type.size )
+                    throw std::runtime_error( "Snapshot type has changed size" );
+
+                tables[i] = registered_tables[registered];
+                ops[i] = registered_ops[registered];
+            }
+
+            value_type* values = reinterpret_cast<value_type*>(file.data + header.values_offset);
+            for ( std::size_t i = 0; i < header.count; i++ )
+            {
+                value_type& value = values[i];
+                index_type index;
+                std::memcpy( &index, &value.table, sizeof(index) );
+                if ( index >= header.type_count )
+                    throw std::runtime_error( "Snapshot value has an invalid type" );
+
+                value.table = tables[index];
+                value.storage.ops = ops[index];
+            }
+
+            return Mapped( std::move(file), std::span<value_type>( values, header.count ) );
+        }
+
+    private:
+        static constexpr std::uint64_t ValuesOffset( std::uint64_t type_count )
+        {
+            const std::uint64_t end = sizeof(detail::SnapshotHeader) + type_count * sizeof(detail::SnapshotType);
+            return ( end + detail::snapshot_value_alignment - 1 ) / detail::snapshot_value_alignment * detail::snapshot_value_alignment;
+        }
+
+        static std::size_t Offset( const value_type& value, const void* member )
+        {
+            return static_cast<std::size_t>( static_cast<const std::byte*>(member) - reinterpret_cast<const std::byte*>(&value) );
+        }
+
+        static inline const detail::StorageOps* const registered_ops[] = { &detail::storage_ops<TyTypes>... };
+        static inline const std::uint64_t registered_ids[] = { stable_type_id<TyTypes>... };
+        static inline const std::uint64_t registered_sizes[] = { sizeof(TyTypes)... };
+        static inline const table_type registered_tables[] = { trait_type::MakeTable( trait_type::template StaticTable<TyTypes, false>() )... };
+    };
+}
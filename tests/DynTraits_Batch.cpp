@@ -0,0 +1,330 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Batch.h"
+
+namespace batch
+{
+
+struct Circle
+{
+    double move = 0.0;
+    int draw_count = 0;
+};
+
+struct Rectangle
+{
+    double move = 0.0;
+    int draw_count = 0;
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Move : DynTrt::Method<void, void(DynTrt::Self, double x, double y)> {};
+    struct Draw : DynTrt::Method<void, int(DynTrt::ConstSelf)> {};
+
+    using Moveable = DynTrt::Trait<Shape, Move, Draw>;
+
+    using MoveAll = DynTrt::BatchMethod<Shape, Move>;
+    using BatchMoveable = DynTrt::Trait<Shape, Move, MoveAll>;
+};
+
+// Calls of the Circle kernel and number of circles they were given.
+int kernel_calls = 0;
+std::size_t kernel_objects = 0;
+
+template<>
+void Shape::Invoke<Shape::Move>( Circle* self, double x, double y )
+{
+    self->move += 2.0 * (x + y);
+}
+
+template<>
+void Shape::Invoke<Shape::Move>( Rectangle* self, double x, double y )
+{
+    self->move += x + y;
+}
+
+template<>
+int Shape::Invoke<Shape::Draw>( const Circle* self )
+{
+    return self->draw_count;
+}
+
+template<>
+int Shape::Invoke<Shape::Draw>( const Rectangle* self )
+{
+    return self->draw_count;
+}
+
+}
+
+template<>
+template<>
+void DynTrt::BatchMethod<batch::Shape, batch::Shape::Move>::Invoke( std::span<batch::Circle> circles, double x, double y )
+{
+    batch::kernel_calls++;
+    batch::kernel_objects += circles.size();
+
+    const double offset = 2.0 * (x + y);
+    for ( batch::Circle& circle : circles )
+        circle.move += offset;
+}
+
+TEST_CASE("Batch Call", "[Batch]")
+{
+    using namespace batch;
+
+    std::vector<Circle> circles(3);
+    std::vector<Rectangle> rectangles(3);
+
+    std::vector<Shape::Moveable> shapes;
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        shapes.emplace_back( &circles[i] );
+        shapes.emplace_back( &rectangles[i] );
+    }
+
+    SECTION("Unpartitioned")
+    {
+        DynTrt::BatchCall<Shape::Move>( shapes, 0.5, 0.25 );
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            REQUIRE( circles[i].move == 1.5 );
+            REQUIRE( rectangles[i].move == 0.75 );
+        }
+    }
+
+    SECTION("Partitioned")
+    {
+        DynTrt::Partition( shapes );
+
+        // all circles first or all rectangles first, original order kept within a type
+        const bool circles_first = shapes.front().Get<Circle>() != nullptr;
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            if ( circles_first )
+            {
+                REQUIRE( shapes[i].Get<Circle>() == &circles[i] );
+                REQUIRE( shapes[i + 3].Get<Rectangle>() == &rectangles[i] );
+            }
+            else
+            {
+                REQUIRE( shapes[i].Get<Rectangle>() == &rectangles[i] );
+                REQUIRE( shapes[i + 3].Get<Circle>() == &circles[i] );
+            }
+        }
+
+        DynTrt::BatchCall<Shape::Move>( shapes, 0.5, 0.25 );
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            REQUIRE( circles[i].move == 1.5 );
+            REQUIRE( rectangles[i].move == 0.75 );
+        }
+    }
+
+    SECTION("Const")
+    {
+        circles[0].draw_count = 1;
+        const std::vector<Shape::Moveable>& view = shapes;
+        DynTrt::BatchCall<Shape::Draw>( view );
+        REQUIRE( circles[0].draw_count == 1 );
+    }
+}
+
+TEST_CASE("Batch Method", "[Batch]")
+{
+    using namespace batch;
+
+    kernel_calls = 0;
+    kernel_objects = 0;
+
+    std::vector<Circle> circles(4);
+    std::vector<Rectangle> rectangles(4);
+
+    std::vector<Shape::BatchMoveable> shapes;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        shapes.emplace_back( &circles[i] );
+        shapes.emplace_back( &rectangles[i] );
+    }
+
+    SECTION("Unpartitioned")
+    {
+        // every run is a single object
+        DynTrt::BatchCall<Shape::MoveAll>( shapes, 0.5, 0.25 );
+        REQUIRE( kernel_calls == 4 );
+        REQUIRE( kernel_objects == 4 );
+        for ( size_t i = 0; i < 4; i++ )
+        {
+            REQUIRE( circles[i].move == 1.5 );
+            REQUIRE( rectangles[i].move == 0.75 );
+        }
+    }
+
+    SECTION("Partitioned")
+    {
+        DynTrt::Partition( shapes );
+        DynTrt::BatchCall<Shape::MoveAll>( shapes, 0.5, 0.25 );
+        REQUIRE( kernel_calls == 1 );
+        REQUIRE( kernel_objects == 4 );
+        for ( size_t i = 0; i < 4; i++ )
+        {
+            REQUIRE( circles[i].move == 1.5 );
+            REQUIRE( rectangles[i].move == 0.75 );
+        }
+    }
+
+    SECTION("Not Contiguous")
+    {
+        // same type run, but the circles are not in storage order
+        std::vector<Shape::BatchMoveable> reversed;
+        for ( size_t i = 4; i > 0; i-- )
+            reversed.emplace_back( &circles[i - 1] );
+
+        DynTrt::BatchCall<Shape::MoveAll>( reversed, 0.5, 0.25 );
+        REQUIRE( kernel_calls == 4 );
+        REQUIRE( circles[0].move == 1.5 );
+    }
+
+    SECTION("Scalar")
+    {
+        shapes[0].Call<Shape::Move>( 0.5, 0.25 );
+        REQUIRE( circles[0].move == 1.5 );
+        REQUIRE( kernel_calls == 0 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Batch]"
+// Branch misses can be compared by running the same under `perf stat -e branch-misses`.
+TEST_CASE("Batch Call Benchmark", "[.][Benchmark][Batch]")
+{
+    using namespace batch;
+
+    static std::mt19937 generator;
+    std::uniform_int_distribution<int> distribution{10, 1000};
+    std::vector<std::unique_ptr<char[]>> fragments;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        fragments.emplace_back( new char[distribution(generator)] );
+    }
+
+    std::uniform_int_distribution<int> dist{0, 1};
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<std::unique_ptr<Rectangle>> rectangles;
+    std::vector<Shape::Moveable> shapes;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        if ( dist(generator) )
+        {
+            circles.emplace_back( std::make_unique<Circle>() );
+            shapes.emplace_back( circles.back().get() );
+        }
+        else
+        {
+            rectangles.emplace_back( std::make_unique<Rectangle>() );
+            shapes.emplace_back( rectangles.back().get() );
+        }
+    }
+
+    std::vector<Shape::Moveable> partitioned = shapes;
+    DynTrt::Partition( partitioned );
+
+    BENCHMARK( "Trait Vector" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( auto& shape : shapes )
+                shape.Call<Shape::Move>(0.5, 1.0);
+        }
+        return shapes.size();
+    };
+
+    BENCHMARK( "Trait Vector Batch" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            DynTrt::BatchCall<Shape::Move>( shapes, 0.5, 1.0 );
+
+        return shapes.size();
+    };
+
+    BENCHMARK( "Trait Vector Partitioned" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( auto& shape : partitioned )
+                shape.Call<Shape::Move>(0.5, 1.0);
+        }
+        return partitioned.size();
+    };
+
+    BENCHMARK( "Trait Vector Partitioned Batch" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            DynTrt::BatchCall<Shape::Move>( partitioned, 0.5, 1.0 );
+
+        return partitioned.size();
+    };
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][BatchMethod]"
+TEST_CASE("Batch Method Benchmark", "[.][Benchmark][BatchMethod]")
+{
+    using namespace batch;
+
+    // Objects in contiguous storage, handles grouped by type in storage order.
+    std::vector<Circle> circles(10000);
+    std::vector<Rectangle> rectangles(10000);
+    std::vector<Shape::BatchMoveable> shapes;
+    for ( auto& circle : circles )
+        shapes.emplace_back( &circle );
+    for ( auto& rectangle : rectangles )
+        shapes.emplace_back( &rectangle );
+
+    BENCHMARK( "Scalar Batch Call" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            DynTrt::BatchCall<Shape::Move>( shapes, 0.5, 1.0 );
+
+        return shapes.size();
+    };
+
+    BENCHMARK( "Batch Method" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            DynTrt::BatchCall<Shape::MoveAll>( shapes, 0.5, 1.0 );
+
+        return shapes.size();
+    };
+}
@@ -0,0 +1,307 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Box.h"
+
+namespace box
+{
+
+// Names of destroyed objects in the order they were destroyed.
+std::vector<std::string> destroyed;
+
+struct Circle
+{
+    Circle( std::string name, double r ): name(std::move(name)), r(r) {}
+    ~Circle() { destroyed.push_back( name ); }
+
+    std::string name;
+    double r;
+};
+
+struct Square
+{
+    double size = 1.0;
+};
+
+struct Throwing
+{
+    Throwing() { throw std::runtime_error("construction failed"); }
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Area  : DynTrt::Method<void, double(DynTrt::ConstSelf)> {};
+    struct Scale : DynTrt::Method<void, void(DynTrt::Self, double scale)> {};
+
+    using Drawable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Narrowable>, Area, Scale>;
+    using Measurable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Narrowable>, Area>;
+};
+
+template<>
+double Shape::Invoke<Shape::Area>( const Circle* self )
+{
+    return 3.0 * self->r * self->r;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Circle* self, double scale )
+{
+    self->r *= scale;
+}
+
+template<>
+double Shape::Invoke<Shape::Area>( const Square* self )
+{
+    return self->size * self->size;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Square* self, double scale )
+{
+    self->size *= scale;
+}
+
+template<>
+double Shape::Invoke<Shape::Area>( const Throwing* )
+{
+    return 0.0;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Throwing*, double )
+{
+}
+
+}
+
+TEST_CASE("Box", "[Box]")
+{
+    using namespace box;
+    using Box = DynTrt::Box<Shape::Drawable>;
+    destroyed.clear();
+
+    SECTION("Owns")
+    {
+        {
+            Box circle = Box::Make<Circle>( "a", 1.0 );
+            REQUIRE( circle );
+            REQUIRE( circle.Call<Shape::Area>() == 3.0 );
+            circle.Call<Shape::Scale>( 2.0 );
+            REQUIRE( circle.Call<Shape::Area>() == 12.0 );
+            REQUIRE( circle.Get<Circle>()->r == 2.0 );
+            REQUIRE( circle.Get<Square>() == nullptr );
+            REQUIRE( circle.Type() == DynTrt::type_id<Circle> );
+            REQUIRE( destroyed.empty() );
+        }
+        REQUIRE( destroyed == std::vector<std::string>{ "a" } );
+    }
+
+    SECTION("Move")
+    {
+        static_assert( std::is_nothrow_move_constructible_v<Box> && std::is_nothrow_move_assignable_v<Box> );
+
+        Box a = Box::Make<Circle>( "a", 1.0 );
+        Box b = std::move(a);
+        REQUIRE( ! a );
+        REQUIRE( b.Call<Shape::Area>() == 3.0 );
+
+        b = Box::Make<Square>();
+        REQUIRE( destroyed == std::vector<std::string>{ "a" } );
+        REQUIRE( b.Call<Shape::Area>() == 1.0 );
+
+        b.Reset();
+        REQUIRE( ! b );
+    }
+
+    SECTION("View")
+    {
+        Box circle = Box::Make<Circle>( "a", 1.0 );
+        Shape::Drawable drawable = circle.View();
+        drawable.Call<Shape::Scale>( 2.0 );
+        Shape::Measurable measurable = circle.View<Shape::Measurable>();
+        REQUIRE( measurable.Call<Shape::Area>() == 12.0 );
+        REQUIRE( measurable.Type() == DynTrt::type_id<Circle> );
+
+        // views of boxed objects group with plain handles of the same type
+        Circle plain{ "plain", 1.0 };
+        REQUIRE( circle.View().Identity() == Shape::Drawable(&plain).Identity() );
+        DynTrt::Arena arena;
+        Box arena_circle = arena.MakeBox<Shape::Drawable, Circle>( "arena", 1.0 );
+        REQUIRE( arena_circle.View().Identity() == Shape::Drawable(&plain).Identity() );
+        arena_circle.Reset();
+
+        // a const box only gives out const access, even once the view is copied
+        const Box& const_circle = circle;
+        Shape::Drawable const_view = const_circle.View();
+        REQUIRE( const_view.Get<Circle>() == nullptr );
+        REQUIRE( const_view.Get<const Circle>() == circle.Get<Circle>() );
+        Shape::Measurable const_measurable = const_circle.View<Shape::Measurable>();
+        REQUIRE( const_measurable.Type() == DynTrt::type_id<const Circle> );
+    }
+}
+
+TEST_CASE("Arena", "[Box]")
+{
+    using namespace box;
+    using Box = DynTrt::Box<Shape::Drawable>;
+    destroyed.clear();
+
+    DynTrt::Arena arena{ 256 };
+
+    SECTION("New and Make")
+    {
+        Circle* a = arena.New<Circle>( "a", 1.0 );
+        Shape::Drawable b = arena.Make<Shape::Drawable, Circle>( "b", 2.0 );
+        Shape::Drawable square = arena.Make<Shape::Drawable, Square>();
+        REQUIRE( a->r == 1.0 );
+        REQUIRE( b.Call<Shape::Area>() == 12.0 );
+        REQUIRE( square.Call<Shape::Area>() == 1.0 );
+
+        // more than a block
+        std::vector<Circle*> circles;
+        for ( int i = 0; i < 100; i++ )
+            circles.push_back( arena.New<Circle>( std::to_string(i), 1.0 ) );
+        for ( int i = 0; i < 100; i++ )
+            REQUIRE( circles[i]->name == std::to_string(i) );
+
+        arena.Reset();
+        REQUIRE( destroyed.size() == 102 );
+        REQUIRE( destroyed.front() == "99" );
+        REQUIRE( destroyed.back() == "a" );
+    }
+
+    SECTION("Destroyed With Arena")
+    {
+        {
+            DynTrt::Arena scoped;
+            scoped.New<Circle>( "a", 1.0 );
+            scoped.New<Circle>( "b", 1.0 );
+        }
+        REQUIRE( destroyed == std::vector<std::string>{ "b", "a" } );
+    }
+
+    SECTION("Boxes")
+    {
+        Box a = arena.MakeBox<Shape::Drawable, Circle>( "a", 1.0 );
+        Box square = arena.MakeBox<Shape::Drawable, Square>();
+        REQUIRE( arena.Boxes() == 2 );
+        REQUIRE( a.Call<Shape::Area>() == 3.0 );
+        REQUIRE( square.Call<Shape::Area>() == 1.0 );
+
+        // a's memory is reused by the next circle, not by other types
+        const void* address = a.Get<Circle>();
+        a.Reset();
+        REQUIRE( destroyed == std::vector<std::string>{ "a" } );
+        REQUIRE( arena.Boxes() == 1 );
+
+        Box other = arena.MakeBox<Shape::Drawable, Square>();
+        REQUIRE( static_cast<const void*>(other.Get<Square>()) != address );
+
+        Box b = arena.MakeBox<Shape::Drawable, Circle>( "b", 2.0 );
+        REQUIRE( static_cast<const void*>(b.Get<Circle>()) == address );
+        REQUIRE( b.Call<Shape::Area>() == 12.0 );
+
+        b.Reset();
+        other.Reset();
+        square.Reset();
+        REQUIRE( arena.Boxes() == 0 );
+        arena.Reset();
+        REQUIRE( destroyed == std::vector<std::string>{ "a", "b" } );
+    }
+
+    SECTION("Exception")
+    {
+        REQUIRE_THROWS_AS( (arena.MakeBox<Shape::Drawable, Throwing>()), std::runtime_error );
+        REQUIRE_THROWS_AS( (arena.New<Throwing>()), std::runtime_error );
+        REQUIRE( arena.Boxes() == 0 );
+    }
+
+    SECTION("Resource")
+    {
+        std::pmr::vector<int> values{ arena.Resource() };
+        for ( int i = 0; i < 100; i++ )
+            values.push_back( i );
+        REQUIRE( values[99] == 99 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Box]"
+TEST_CASE("Box Benchmark", "[.][Benchmark][Box]")
+{
+    using namespace box;
+    using Box = DynTrt::Box<Shape::Drawable>;
+    constexpr size_t count = 10000;
+
+    std::mt19937 generator;
+    std::vector<bool> is_circle( count );
+    for ( size_t i = 0; i < count; i++ )
+        is_circle[i] = generator() % 2;
+
+    const auto sum = []( const auto& shapes ) {
+        double total = 0.0;
+        for ( const auto& shape : shapes )
+            total += shape.template Call<Shape::Area>();
+        return total;
+    };
+
+    BENCHMARK( "Heap Box" )
+    {
+        std::vector<Box> shapes;
+        shapes.reserve( count );
+        for ( size_t i = 0; i < count; i++ )
+            shapes.push_back( is_circle[i] ? Box::Make<Circle>( "", 1.0 ) : Box::Make<Square>() );
+        return sum( shapes );
+    };
+
+    BENCHMARK( "Arena Make" )
+    {
+        DynTrt::Arena arena;
+        std::vector<Shape::Drawable> shapes;
+        shapes.reserve( count );
+        for ( size_t i = 0; i < count; i++ )
+            shapes.push_back( is_circle[i] ? arena.Make<Shape::Drawable, Circle>( "", 1.0 ) : arena.Make<Shape::Drawable, Square>() );
+        return sum( shapes );
+    };
+
+    DynTrt::Arena arena;
+    BENCHMARK( "Arena Box" )
+    {
+        std::vector<Box> shapes;
+        shapes.reserve( count );
+        for ( size_t i = 0; i < count; i++ )
+            shapes.push_back( is_circle[i] ? arena.MakeBox<Shape::Drawable, Circle>( "", 1.0 ) : arena.MakeBox<Shape::Drawable, Square>() );
+        return sum( shapes );
+    };
+}
@@ -0,0 +1,245 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Closed.h"
+
+namespace closed
+{
+
+struct Circle
+{
+    double x = 0.0;
+    double y = 0.0;
+    double r = 1.0;
+    int draw_count = 0;
+};
+
+struct Rectangle
+{
+    double x = 0.0;
+    double y = 0.0;
+    double width = 1.0;
+    double height = 1.0;
+    int draw_count = 0;
+    // non trivial member to exercise copy and destroy
+    std::shared_ptr<int> owner;
+};
+
+// Copies and moves throw once armed.
+struct Fragile
+{
+    Fragile()=default;
+    Fragile( const Fragile& other ): armed(other.armed) { if ( armed ) throw std::runtime_error("copy failed"); }
+    Fragile( Fragile&& other ): armed(other.armed) { if ( armed ) throw std::runtime_error("move failed"); }
+
+    double x = 0.0;
+    double y = 0.0;
+    int draw_count = 0;
+    bool armed = false;
+};
+
+// Not part of the closed set.
+struct Triangle {};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Draw : DynTrt::Method<Draw, int(DynTrt::ConstSelf)> {
+        template<typename T>
+        static int Invoke( const T* self ) { return self->draw_count; }
+    };
+    struct Move : DynTrt::Method<Move, void(DynTrt::Self, double x, double y)> {
+        template<typename T>
+        static void Invoke( T* self, double x, double y ) {
+            self->x += x;
+            self->y += y;
+        }
+    };
+    struct Scale : DynTrt::Method<void, void(DynTrt::Self, double scale)> {};
+
+    using Closed = DynTrt::ClosedTrait<Shape, DynTrt::Types<Circle, Rectangle>, Draw, Move, Scale>;
+    using Open = DynTrt::Trait<Shape, Draw, Move, Scale>;
+    using Movable = DynTrt::ClosedTrait<Shape, DynTrt::Types<Circle, Rectangle, Fragile>, Draw, Move>;
+};
+
+template<>
+void Shape::Invoke<Shape::Scale>( Circle* self, double scale )
+{
+    self->r *= scale;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Rectangle* self, double scale )
+{
+    self->width *= scale;
+    self->height *= scale;
+}
+
+}
+
+TEST_CASE("Closed Trait", "[Closed]")
+{
+    using namespace closed;
+
+    static_assert( sizeof(Shape::Closed) == sizeof(Rectangle) + alignof(Rectangle) );
+
+    SECTION("Call")
+    {
+        Shape::Closed shape = Circle{};
+        shape.Call<Shape::Move>( 0.5, 0.25 );
+        shape.Call<Shape::Scale>( 0.5 );
+
+        REQUIRE( shape.Get<Rectangle>() == nullptr );
+        REQUIRE( shape.Get<Circle>() != nullptr );
+        REQUIRE( shape.Get<Circle>()->x == 0.5 );
+        REQUIRE( shape.Get<Circle>()->y == 0.25 );
+        REQUIRE( shape.Get<Circle>()->r == 0.5 );
+
+        const Shape::Closed& view = shape;
+        shape.Get<Circle>()->draw_count = 3;
+        REQUIRE( view.Call<Shape::Draw>() == 3 );
+
+        shape = Rectangle{};
+        REQUIRE( shape.Tag() == Shape::Closed::tag_of<Rectangle> );
+        shape.Call<Shape::Scale>( 2.0 );
+        REQUIRE( shape.Get<Rectangle>()->width == 2.0 );
+    }
+
+    SECTION("Lifetime")
+    {
+        std::shared_ptr<int> owner = std::make_shared<int>(1);
+        {
+            Shape::Closed shape = Rectangle{ .owner = owner };
+            REQUIRE( owner.use_count() == 2 );
+
+            Shape::Closed copy = shape;
+            REQUIRE( owner.use_count() == 3 );
+
+            copy = Circle{};
+            REQUIRE( owner.use_count() == 2 );
+        }
+        REQUIRE( owner.use_count() == 1 );
+    }
+
+    SECTION("Throwing Assignment")
+    {
+        std::shared_ptr<int> owner = std::make_shared<int>(1);
+        Shape::Movable fragile = Fragile{};
+        fragile.Get<Fragile>()->armed = true;
+
+        // the copy is made first so the target keeps its value
+        Shape::Movable shape = Rectangle{ .owner = owner };
+        REQUIRE_THROWS_AS( shape = fragile, std::runtime_error );
+        REQUIRE( shape.Get<Rectangle>() != nullptr );
+        REQUIRE( owner.use_count() == 2 );
+
+        // a throwing move leaves it valueless, the old value destroyed once
+        REQUIRE_THROWS_AS( shape = std::move(fragile), std::runtime_error );
+        REQUIRE( shape.Valueless() );
+        REQUIRE( owner.use_count() == 1 );
+
+        shape = Circle{};
+        REQUIRE( shape.Get<Circle>() != nullptr );
+    }
+
+    SECTION("Foreign Types")
+    {
+        Shape::Closed shape = Circle{};
+        REQUIRE( shape.Get<Triangle>() == nullptr );
+        REQUIRE( Shape::Closed::tag_of<Triangle> != Shape::Closed::tag_of<Circle> );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Closed]"
+TEST_CASE("Closed Trait Benchmark", "[.][Benchmark][Closed]")
+{
+    using namespace closed;
+    using Variant = std::variant<Circle, Rectangle>;
+
+    static std::mt19937 generator;
+    std::uniform_int_distribution<int> dist{0, 1};
+
+    std::vector<Shape::Closed> closed_shapes;
+    std::vector<Variant> variant_shapes;
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<std::unique_ptr<Rectangle>> rectangles;
+    std::vector<Shape::Open> open_shapes;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        if ( dist(generator) )
+        {
+            closed_shapes.emplace_back( Circle{} );
+            variant_shapes.emplace_back( Circle{} );
+            circles.emplace_back( std::make_unique<Circle>() );
+            open_shapes.emplace_back( circles.back().get() );
+        }
+        else
+        {
+            closed_shapes.emplace_back( Rectangle{} );
+            variant_shapes.emplace_back( Rectangle{} );
+            rectangles.emplace_back( std::make_unique<Rectangle>() );
+            open_shapes.emplace_back( rectangles.back().get() );
+        }
+    }
+
+    BENCHMARK( "Closed Vector" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( auto& shape : closed_shapes )
+                shape.Call<Shape::Move>(0.5, 1.0);
+        }
+        return closed_shapes.size();
+    };
+
+    BENCHMARK( "Variant Vector" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( auto& shape : variant_shapes )
+                std::visit([]( auto& value ) { Shape::Move::Invoke(&value, 0.5, 1.0); }, shape);
+        }
+        return variant_shapes.size();
+    };
+
+    BENCHMARK( "Trait Vector" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( auto& shape : open_shapes )
+                shape.Call<Shape::Move>(0.5, 1.0);
+        }
+        return open_shapes.size();
+    };
+}
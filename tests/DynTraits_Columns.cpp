@@ -0,0 +1,206 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Batch.h"
+#include "Columns.h"
+#include "Shapes.h"
+
+namespace columns
+{
+
+using shapes::Circle;
+using shapes::Rectangle;
+
+// The shared shapes with a batch kernel of their own, so the specialization below stays in this file.
+struct Shape : shapes::Shape
+{
+    using MoveAll = DynTrt::BatchMethod<Shape, Move>;
+    using Moveable = DynTrt::Trait<Shape, Move, Area, MoveAll>;
+    using Shapes = DynTrt::PolyColumns<Moveable, Circle, Rectangle>;
+};
+
+int kernel_calls = 0;
+
+// Fails to convert to a radius.
+struct BadRadius
+{
+    operator double() const { throw std::runtime_error("bad radius"); }
+};
+
+}
+
+template<>
+template<>
+void DynTrt::BatchMethod<columns::Shape, columns::Shape::Move>::Invoke( std::span<columns::Rectangle> rectangles, double x, double y )
+{
+    columns::kernel_calls++;
+    for ( columns::Rectangle& rectangle : rectangles )
+        rectangle.move += x + y;
+}
+
+TEST_CASE("PolyColumns", "[Columns]")
+{
+    using namespace columns;
+
+    Shape::Shapes shapes;
+    auto a = shapes.Insert( Circle{ 1.0 } );
+    auto b = shapes.Insert( Rectangle{} );
+    auto c = shapes.Emplace<Circle>( 3.0 );
+    auto d = shapes.Insert( Rectangle{} );
+
+    REQUIRE( shapes.Size() == 4 );
+    REQUIRE( shapes.Column<Circle>().size() == 2 );
+    REQUIRE( shapes.Column<Rectangle>().size() == 2 );
+
+    SECTION("Get")
+    {
+        REQUIRE( shapes.Get<Circle>(a)->r == 1.0 );
+        REQUIRE( shapes.Get<Circle>(c)->r == 3.0 );
+        REQUIRE( shapes.Get<Rectangle>(a) == nullptr );
+        REQUIRE( shapes.Get<Rectangle>(b) != nullptr );
+        REQUIRE( shapes.Get<Circle>(Shape::Shapes::Handle{}) == nullptr );
+    }
+
+    SECTION("Throwing Emplace")
+    {
+        REQUIRE_THROWS_AS( shapes.Emplace<Circle>( BadRadius{} ), std::runtime_error );
+        REQUIRE( shapes.Size() == 4 );
+        REQUIRE( shapes.Column<Circle>().size() == 2 );
+
+        auto e = shapes.Insert( Circle{ 5.0 } );
+        REQUIRE( shapes.Get<Circle>(e)->r == 5.0 );
+        REQUIRE( shapes.Erase(a) );
+        REQUIRE( shapes.Get<Circle>(e)->r == 5.0 );
+        REQUIRE( shapes.Get<Circle>(c)->r == 3.0 );
+    }
+
+    SECTION("Erase")
+    {
+        REQUIRE( shapes.Erase(a) );
+        REQUIRE( ! shapes.Erase(a) );
+        REQUIRE( ! shapes.Contains(a) );
+        REQUIRE( shapes.Get<Circle>(a) == nullptr );
+        REQUIRE_THROWS_AS( shapes.At(a), std::out_of_range );
+
+        // c was moved into the gap and its handle still finds it
+        REQUIRE( shapes.Size() == 3 );
+        REQUIRE( shapes.Column<Circle>().size() == 1 );
+        REQUIRE( shapes.Get<Circle>(c)->r == 3.0 );
+        REQUIRE( shapes.Get<Circle>(c) == &shapes.Column<Circle>()[0] );
+
+        // the slot is reused with a new generation, the old handle stays dead
+        auto e = shapes.Insert( Circle{ 5.0 } );
+        REQUIRE( e.slot == a.slot );
+        REQUIRE( e.generation != a.generation );
+        REQUIRE( shapes.Get<Circle>(a) == nullptr );
+        REQUIRE( shapes.Get<Circle>(e)->r == 5.0 );
+
+        REQUIRE( shapes.Erase(d) );
+        REQUIRE( shapes.Erase(b) );
+        REQUIRE( shapes.Column<Rectangle>().empty() );
+    }
+
+    SECTION("At")
+    {
+        Shape::Moveable moveable = shapes.At(c);
+        moveable.Call<Shape::Move>( 0.5, 0.25 );
+        REQUIRE( shapes.Get<Circle>(c)->move == 1.5 );
+        REQUIRE( moveable.Get<Circle>() == shapes.Get<Circle>(c) );
+        REQUIRE( shapes.At(d).Call<Shape::Area>() == 4.0 );
+        REQUIRE( shapes.At(c).Call<Shape::Area>() == 27.0 );
+    }
+
+    SECTION("Call")
+    {
+        shapes.Call<Shape::Move>( 0.5, 0.25 );
+        for ( const Circle& circle : shapes.Column<Circle>() )
+            REQUIRE( circle.move == 1.5 );
+        for ( const Rectangle& rectangle : shapes.Column<Rectangle>() )
+            REQUIRE( rectangle.move == 0.75 );
+
+        const Shape::Shapes& view = shapes;
+        view.Call<Shape::Area>();
+    }
+
+    SECTION("Batch")
+    {
+        kernel_calls = 0;
+        shapes.Call<Shape::MoveAll>( 0.5, 0.25 );
+        REQUIRE( kernel_calls == 1 );
+        for ( const Circle& circle : shapes.Column<Circle>() )
+            REQUIRE( circle.move == 1.5 );
+        for ( const Rectangle& rectangle : shapes.Column<Rectangle>() )
+            REQUIRE( rectangle.move == 0.75 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Columns]"
+TEST_CASE("PolyColumns Benchmark", "[.][Benchmark][Columns]")
+{
+    using namespace columns;
+
+    Shape::Shapes shapes;
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<std::unique_ptr<Rectangle>> rectangles;
+    std::vector<Shape::Moveable> handles;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        if ( i % 2 )
+        {
+            shapes.Insert( Circle{} );
+            circles.emplace_back( std::make_unique<Circle>() );
+            handles.emplace_back( circles.back().get() );
+        }
+        else
+        {
+            shapes.Insert( Rectangle{} );
+            rectangles.emplace_back( std::make_unique<Rectangle>() );
+            handles.emplace_back( rectangles.back().get() );
+        }
+    }
+    DynTrt::Partition( handles );
+
+    BENCHMARK( "Handles Partitioned Batch" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            DynTrt::BatchCall<Shape::Move>( handles, 0.5, 1.0 );
+
+        return handles.size();
+    };
+
+    BENCHMARK( "PolyColumns" )
+    {
+        for ( size_t i = 0; i < 100; i++ )
+            shapes.Call<Shape::Move>( 0.5, 1.0 );
+
+        return shapes.Size();
+    };
+}
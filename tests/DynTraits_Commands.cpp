@@ -0,0 +1,335 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Commands.h"
+
+namespace commands
+{
+
+// Calls in the order they ran.
+struct Logged
+{
+    const void* object;
+    std::string method;
+};
+std::vector<Logged> calls;
+
+struct Circle
+{
+    double x = 0.0;
+    double r = 1.0;
+    std::unique_ptr<int> tag;
+};
+
+struct Rectangle
+{
+    double x = 0.0;
+    double width = 1.0;
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Move  : DynTrt::Method<void, void(DynTrt::Self, double x)> {};
+    struct Scale : DynTrt::Method<void, void(DynTrt::Self, double scale)> {};
+    struct Tag   : DynTrt::Method<void, void(DynTrt::Self, std::unique_ptr<int> tag)> {};
+    struct Name  : DynTrt::Method<void, void(DynTrt::ConstSelf, const std::string& name)> {};
+
+    using Moveable = DynTrt::Trait<Shape, Move, Scale>;
+    using Tagged = DynTrt::Trait<Shape, Tag, Name>;
+};
+
+template<>
+void Shape::Invoke<Shape::Move>( Circle* self, double x )
+{
+    calls.push_back( { self, "move" } );
+    self->x += x;
+}
+
+template<>
+void Shape::Invoke<Shape::Move>( Rectangle* self, double x )
+{
+    if ( x < 0.0 )
+        throw std::invalid_argument("negative move");
+
+    calls.push_back( { self, "move" } );
+    self->x += x;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Circle* self, double scale )
+{
+    calls.push_back( { self, "scale" } );
+    self->r *= scale;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Rectangle* self, double scale )
+{
+    calls.push_back( { self, "scale" } );
+    self->width *= scale;
+}
+
+template<>
+void Shape::Invoke<Shape::Tag>( Circle* self, std::unique_ptr<int> tag )
+{
+    self->tag = std::move(tag);
+}
+
+template<>
+void Shape::Invoke<Shape::Name>( const Circle* self, const std::string& name )
+{
+    calls.push_back( { self, name } );
+}
+
+// Moving it records a move of target in the buffer being flushed.
+struct Recorder
+{
+    DynTrt::CommandBuffer* commands;
+    Shape::Moveable target;
+};
+
+template<>
+void Shape::Invoke<Shape::Move>( Recorder* self, double x )
+{
+    calls.push_back( { self, "move" } );
+    self->commands->Record<Shape::Move>( self->target, x );
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Recorder* self, double )
+{
+    calls.push_back( { self, "scale" } );
+}
+
+}
+
+template<typename TyMethod, typename TyHandle, typename... Ts>
+concept Recordable = requires( DynTrt::CommandBuffer& commands, TyHandle& handle, Ts... args ) { commands.Record<TyMethod>( handle, args... ); };
+
+// Recording through a const handle only allows const methods.
+static_assert( Recordable<commands::Shape::Move, commands::Shape::Moveable, double> );
+static_assert( ! Recordable<commands::Shape::Move, const commands::Shape::Moveable, double> );
+static_assert( Recordable<commands::Shape::Name, const commands::Shape::Tagged, std::string> );
+
+TEST_CASE("Command Buffer", "[Commands]")
+{
+    using namespace commands;
+    calls.clear();
+
+    Circle c1, c2;
+    Rectangle r1;
+    Shape::Moveable circle1 = &c1;
+    Shape::Moveable circle2 = &c2;
+    Shape::Moveable rectangle = &r1;
+
+    DynTrt::CommandBuffer commands;
+
+    SECTION("Per Object Order")
+    {
+        commands.Record<Shape::Move>( circle1, 1.0 );
+        commands.Record<Shape::Move>( rectangle, 1.0 );
+        commands.Record<Shape::Scale>( circle1, 2.0 );
+        commands.Record<Shape::Move>( circle2, 1.0 );
+        commands.Record<Shape::Move>( circle1, 1.0 );
+        REQUIRE( commands.Size() == 5 );
+        REQUIRE( calls.empty() );
+
+        commands.Flush();
+        REQUIRE( commands.Empty() );
+        REQUIRE( calls.size() == 5 );
+
+        // move then scale then move for c1, so scale applied to the first move only
+        REQUIRE( c1.x == 2.0 );
+        REQUIRE( c1.r == 2.0 );
+        std::vector<std::string> c1_calls;
+        for ( const Logged& entry : calls )
+        {
+            if ( entry.object == &c1 )
+                c1_calls.push_back( entry.method );
+        }
+        REQUIRE( c1_calls == std::vector<std::string>{ "move", "scale", "move" } );
+
+        // the first command of every object runs first, with the circles next to each other
+        const auto is_circle = [&]( const Logged& entry ) { return entry.object == &c1 || entry.object == &c2; };
+        REQUIRE( is_circle(calls[1]) );
+        REQUIRE( std::count_if( calls.begin(), calls.begin() + 3, is_circle ) == 2 );
+        REQUIRE( calls[3].method == "scale" );
+    }
+
+    SECTION("Grouped")
+    {
+        commands.Record<Shape::Move>( circle1, 1.0 );
+        commands.Record<Shape::Move>( rectangle, 1.0 );
+        commands.Record<Shape::Move>( circle2, 1.0 );
+        commands.Flush();
+
+        REQUIRE( calls.size() == 3 );
+        const bool circles_first = calls[0].object != &r1;
+        if ( circles_first )
+        {
+            REQUIRE( calls[0].object == &c1 );
+            REQUIRE( calls[1].object == &c2 );
+        }
+        else
+        {
+            REQUIRE( calls[1].object == &c1 );
+            REQUIRE( calls[2].object == &c2 );
+        }
+    }
+
+    SECTION("Move Only Arguments")
+    {
+        Shape::Tagged tagged = &c1;
+        const Shape::Tagged& const_tagged = tagged;
+        std::string name = "named";
+        commands.Record<Shape::Tag>( tagged, std::make_unique<int>(3) );
+        commands.Record<Shape::Name>( const_tagged, name );
+        name = "changed";
+        commands.Flush();
+
+        REQUIRE( c1.tag );
+        REQUIRE( *c1.tag == 3 );
+        REQUIRE( calls.back().method == "named" );
+    }
+
+    SECTION("Clear")
+    {
+        Shape::Tagged tagged = &c1;
+        commands.Record<Shape::Move>( circle1, 1.0 );
+        commands.Record<Shape::Tag>( tagged, std::make_unique<int>(3) );
+        commands.Clear();
+        commands.Flush();
+        REQUIRE( c1.x == 0.0 );
+        REQUIRE( ! c1.tag );
+        REQUIRE( calls.empty() );
+    }
+
+    SECTION("Exception")
+    {
+        commands.Record<Shape::Move>( rectangle, -1.0 );
+        commands.Record<Shape::Move>( rectangle, 1.0 );
+        REQUIRE_THROWS_AS( commands.Flush(), std::invalid_argument );
+        REQUIRE( commands.Empty() );
+        REQUIRE( r1.x == 0.0 );
+
+        commands.Record<Shape::Move>( rectangle, 1.0 );
+        commands.Flush();
+        REQUIRE( r1.x == 1.0 );
+    }
+
+    SECTION("Record While Flushing")
+    {
+        Recorder recorder{ &commands, circle1 };
+        Shape::Moveable recording = &recorder;
+        commands.Record<Shape::Move>( recording, 1.0 );
+        commands.Flush();
+        REQUIRE( c1.x == 0.0 );
+        REQUIRE( commands.Size() == 1 );
+
+        // recorded after it, must not overwrite the pending command
+        commands.Record<Shape::Move>( circle2, 2.0 );
+        commands.Flush();
+        REQUIRE( c1.x == 1.0 );
+        REQUIRE( c2.x == 2.0 );
+        REQUIRE( commands.Empty() );
+    }
+
+    SECTION("Chunks")
+    {
+        DynTrt::CommandBuffer small{ 64 };
+        for ( int i = 0; i < 100; i++ )
+            small.Record<Shape::Move>( i % 2 ? circle1 : rectangle, 1.0 );
+
+        // second round reuses the chunks
+        for ( int round = 0; round < 2; round++ )
+        {
+            small.Flush();
+            for ( int i = 0; i < 100; i++ )
+                small.Record<Shape::Move>( i % 2 ? circle1 : rectangle, 1.0 );
+        }
+        small.Flush();
+        REQUIRE( c1.x == 150.0 );
+        REQUIRE( r1.x == 150.0 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Commands]"
+TEST_CASE("Command Buffer Benchmark", "[.][Benchmark][Commands]")
+{
+    using namespace commands;
+
+    std::mt19937 generator;
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<std::unique_ptr<Rectangle>> rectangles;
+    std::vector<Shape::Moveable> shapes;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        if ( generator() % 2 )
+        {
+            circles.emplace_back( std::make_unique<Circle>() );
+            shapes.emplace_back( circles.back().get() );
+        }
+        else
+        {
+            rectangles.emplace_back( std::make_unique<Rectangle>() );
+            shapes.emplace_back( rectangles.back().get() );
+        }
+    }
+    DynTrt::CommandBuffer commands;
+
+    BENCHMARK( "Immediate" )
+    {
+        calls.clear();
+        for ( auto& shape : shapes )
+        {
+            shape.Call<Shape::Move>( 1.0 );
+            shape.Call<Shape::Scale>( 1.0 );
+        }
+        return calls.size();
+    };
+
+    BENCHMARK( "Record and Flush" )
+    {
+        calls.clear();
+        for ( auto& shape : shapes )
+        {
+            commands.Record<Shape::Move>( shape, 1.0 );
+            commands.Record<Shape::Scale>( shape, 1.0 );
+        }
+        commands.Flush();
+        return calls.size();
+    };
+}
@@ -0,0 +1,134 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Batch.h"
+#include "Dense.h"
+#include "Shapes.h"
+
+namespace dense
+{
+
+using shapes::Circle;
+using shapes::Rectangle;
+using shapes::Shape;
+
+using Moveable = DynTrt::DenseTrait<Shape, Shape::Move, Shape::Area>;
+
+// Every type implements Value, so the tables can be grown by registering many of them.
+struct Numbered
+{
+    template<typename Method, typename T, typename... Ts>
+    static int Invoke( const T*, Ts... ) { return T::value; }
+
+    struct Value : DynTrt::Method<void, int(DynTrt::ConstSelf)> {};
+
+    using Valued = DynTrt::DenseTrait<Numbered, Value>;
+};
+
+template<int N>
+struct Number
+{
+    static constexpr int value = N;
+};
+
+template<int N>
+inline const Number<N> number{};
+
+template<int... N>
+std::vector<Numbered::Valued> MakeNumbers( std::integer_sequence<int, N...> )
+{
+    return { Numbered::Valued( &number<N> )... };
+}
+
+}
+
+TEST_CASE("Dense Trait", "[Dense]")
+{
+    using namespace dense;
+
+    Circle c;
+    Rectangle r;
+    Moveable circle = &c;
+    Moveable rectangle = &r;
+
+    SECTION("Ids")
+    {
+        static_assert( sizeof(Moveable::id_type) == 2 );
+        REQUIRE( circle.Id() != rectangle.Id() );
+        REQUIRE( circle.Id() == Moveable::IdOf<Circle>() );
+        REQUIRE( Moveable(&c).Id() == circle.Id() );
+        REQUIRE( Moveable::Count() >= 2 );
+        REQUIRE( Moveable::Table<Shape::Move>()[circle.Id()] == circle.Function<Shape::Move>() );
+        REQUIRE( circle.Identity() == Moveable(&c).Identity() );
+        REQUIRE( circle.Identity() != rectangle.Identity() );
+    }
+
+    SECTION("Call")
+    {
+        circle.Call<Shape::Move>(0.5, 1.0);
+        rectangle.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( c.move == 3.0 );
+        REQUIRE( r.move == 1.5 );
+        REQUIRE( std::as_const(circle).Call<Shape::Area>() == 3.0 );
+        REQUIRE( rectangle.Call<Shape::Area>() == 4.0 );
+    }
+
+    SECTION("Get")
+    {
+        REQUIRE( circle.Get<Circle>() == &c );
+        REQUIRE( circle.Get<Rectangle>() == nullptr );
+
+        const Circle* const_circle = &c;
+        Moveable const_handle = const_circle;
+        REQUIRE( const_handle.Id() != circle.Id() );
+        REQUIRE( const_handle.Get<Circle>() == nullptr );
+        REQUIRE( std::as_const(const_handle).Get<Circle>() == &c );
+    }
+
+    SECTION("Growth")
+    {
+        // handles made before the tables grow keep dispatching
+        std::vector<Numbered::Valued> numbers = MakeNumbers( std::make_integer_sequence<int, 40>{} );
+        REQUIRE( Numbered::Valued::Count() == 40 );
+        for ( int i = 0; i < 40; i++ )
+        {
+            REQUIRE( numbers[i].Id() == i );
+            REQUIRE( numbers[i].Call<Numbered::Value>() == i );
+        }
+    }
+
+    SECTION("Batch")
+    {
+        std::vector<Moveable> shapes = { circle, rectangle, circle };
+        DynTrt::Partition( shapes );
+        DynTrt::BatchCall<Shape::Move>( shapes, 0.5, 1.0 );
+        REQUIRE( c.move == 6.0 );
+        REQUIRE( r.move == 1.5 );
+    }
+}
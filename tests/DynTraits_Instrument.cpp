@@ -0,0 +1,133 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
+
+#include "DynTrt.h"
+#include "Any.h"
+#include "Instrument.h"
+#include "Shapes.h"
+
+namespace instrument
+{
+
+using shapes::Circle;
+using shapes::Rectangle;
+using shapes::Shape;
+
+using Counted = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Instrument<>>, Shape::Move, Shape::Area>;
+using Sampled = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Instrument<2>>, Shape::Move>;
+using CountedAny = DynTrt::AnySmall<16, DynTrt::Policy<Shape, DynTrt::Instrument<>>, Shape::Move, Shape::Area>;
+using Plain = DynTrt::Trait<Shape, Shape::Move, Shape::Area>;
+
+// Entries of the snapshot for TyTrait, keyed by method and type name.
+template<typename TyTrait>
+static DynTrt::Instrumentation::CallStats Find( std::string_view method, std::string_view type )
+{
+    const std::string_view trait = DynTrt::detail::type_name<TyTrait>();
+    for ( const auto& entry : DynTrt::Instrumentation::Snapshot() )
+    {
+        if ( entry.trait == trait && entry.method == method && entry.type == type )
+            return entry;
+    }
+    return {};
+}
+
+}
+
+TEST_CASE("Instrumented Calls", "[Instrument]")
+{
+    using namespace instrument;
+    DynTrt::Instrumentation::Reset();
+
+    Circle circle;
+    Rectangle rectangle;
+
+    SECTION("Counts per method and type")
+    {
+        Counted a = &circle;
+        Counted b = &rectangle;
+        const Counted c = static_cast<const Circle*>(&circle);
+
+        for ( int i = 0; i < 3; i++ )
+            a.Call<Shape::Move>(0.5, 1.0);
+        b.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( c.Call<Shape::Area>() == 3.0 );
+
+        REQUIRE( circle.move == 9.0 );
+        REQUIRE( rectangle.move == 1.5 );
+        REQUIRE( Find<Counted>("shapes::Shape::Move", "shapes::Circle").calls == 3 );
+        REQUIRE( Find<Counted>("shapes::Shape::Move", "shapes::Rectangle").calls == 1 );
+        REQUIRE( Find<Counted>("shapes::Shape::Area", "const shapes::Circle").calls == 1 );
+
+        DynTrt::Instrumentation::Reset();
+        REQUIRE( Find<Counted>("shapes::Shape::Move", "shapes::Circle").calls == 0 );
+    }
+
+    SECTION("AnyValue")
+    {
+        CountedAny value = Circle{};
+        value.Call<Shape::Move>(0.5, 1.0);
+        value.Call<Shape::Area>();
+
+        // Shares the vtable of the matching Trait.
+        using trait = CountedAny::trait_type;
+        REQUIRE( Find<trait>("shapes::Shape::Move", "shapes::Circle").calls == 1 );
+        REQUIRE( Find<trait>("shapes::Shape::Area", "shapes::Circle").calls == 1 );
+    }
+
+    SECTION("Sampled latency")
+    {
+        Sampled sampled = &circle;
+        for ( int i = 0; i < 10; i++ )
+            sampled.Call<Shape::Move>(0.5, 1.0);
+
+        const auto entry = Find<Sampled>("shapes::Shape::Move", "shapes::Circle");
+        REQUIRE( entry.calls == 10 );
+        REQUIRE( entry.samples == 5 );
+    }
+
+    SECTION("Export")
+    {
+        Counted a = &circle;
+        a.Call<Shape::Move>(0.5, 1.0);
+
+        const auto snapshot = DynTrt::Instrumentation::Snapshot();
+        const std::string text = DynTrt::Instrumentation::Text(snapshot);
+        const std::string json = DynTrt::Instrumentation::Json(snapshot);
+        REQUIRE( text.find("shapes::Shape::Move shapes::Circle") != std::string::npos );
+        REQUIRE( json.find("\"method\": \"shapes::Shape::Move\", \"type\": \"shapes::Circle\", \"calls\": 1,") != std::string::npos );
+
+        // Most called first.
+        REQUIRE( std::is_sorted( snapshot.begin(), snapshot.end(), []( const auto& x, const auto& y ) { return x.calls > y.calls; } ) );
+    }
+
+    SECTION("Uninstrumented traits are not wrapped")
+    {
+        Plain plain = &circle;
+        REQUIRE( plain.Function<Shape::Move>() == &Shape::Move::Erased<Shape, Shape::Move, Circle> );
+    }
+}
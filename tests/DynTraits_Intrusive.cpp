@@ -0,0 +1,139 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <utility>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Intrusive.h"
+#include "Shapes.h"
+
+namespace intrusive
+{
+
+using shapes::Shape;
+
+using Moveable = DynTrt::Trait<Shape, Shape::Move, Shape::Area>;
+using Thin = DynTrt::ThinTrait<Moveable>;
+
+// The shared shapes with a header in front.
+struct Circle : DynTrt::Intrusive<Moveable, Circle>, shapes::Circle {};
+struct Rectangle : DynTrt::Intrusive<Moveable, Rectangle>, shapes::Rectangle {};
+
+}
+
+// Dispatch as the shapes they extend.
+template<>
+void shapes::Shape::Invoke<shapes::Shape::Move>( intrusive::Circle* self, double x, double y )
+{
+    Invoke<Move>( static_cast<shapes::Circle*>(self), x, y );
+}
+
+template<>
+void shapes::Shape::Invoke<shapes::Shape::Move>( intrusive::Rectangle* self, double x, double y )
+{
+    Invoke<Move>( static_cast<shapes::Rectangle*>(self), x, y );
+}
+
+template<>
+double shapes::Shape::Invoke<shapes::Shape::Area>( const intrusive::Circle* self )
+{
+    return Invoke<Area>( static_cast<const shapes::Circle*>(self) );
+}
+
+template<>
+double shapes::Shape::Invoke<shapes::Shape::Area>( const intrusive::Rectangle* self )
+{
+    return Invoke<Area>( static_cast<const shapes::Rectangle*>(self) );
+}
+
+TEST_CASE("Intrusive Thin Trait", "[Intrusive]")
+{
+    using namespace intrusive;
+    static_assert( sizeof(Thin) == sizeof(void*) );
+
+    Circle c;
+    Rectangle r;
+
+    std::vector<Thin> shapes = { &c, &r };
+    for ( auto& shape : shapes )
+        shape.Call<Shape::Move>(0.5, 1.0);
+
+    REQUIRE( c.move == 3.0 );
+    REQUIRE( r.move == 1.5 );
+    REQUIRE( shapes[0].Call<Shape::Area>() == 3.0 );
+    REQUIRE( shapes[1].Call<Shape::Area>() == 4.0 );
+
+    SECTION("Same table as the wide trait")
+    {
+        Moveable wide = &c;
+        REQUIRE( shapes[0].Identity() == wide.Identity() );
+        REQUIRE( shapes[0].Function<Shape::Move>() == wide.Function<Shape::Move>() );
+
+        Moveable converted = shapes[1].Wide();
+        converted.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( r.move == 3.0 );
+        REQUIRE( converted.Get<Rectangle>() == &r );
+    }
+
+    SECTION("Get")
+    {
+        REQUIRE( shapes[0].Get<Circle>() == &c );
+        REQUIRE( shapes[0].Get<Rectangle>() == nullptr );
+        REQUIRE( shapes[0].Type() == DynTrt::type_id<Circle> );
+
+        // copies carry the header of their own type
+        Circle copy = c;
+        Thin copied = &copy;
+        REQUIRE( copied.Get<Circle>() == &copy );
+    }
+
+    SECTION("Const")
+    {
+        const Circle* const_circle = &c;
+        Thin thin = const_circle;
+        REQUIRE( thin.Get<Circle>() == nullptr );
+        REQUIRE( std::as_const(thin).Get<Circle>() == &c );
+        REQUIRE( thin.Get<const Circle>() == &c );
+        REQUIRE( thin.Call<Shape::Area>() == 3.0 );
+
+        // reported and grouped as a Trait made from the same pointer would be
+        REQUIRE( thin.Type() == DynTrt::type_id<const Circle> );
+        REQUIRE( thin.Identity() == Moveable( const_circle ).Identity() );
+
+        // and never written through, in any build
+        REQUIRE_THROWS_AS( thin.Call<Shape::Move>(0.5, 1.0), std::logic_error );
+        REQUIRE( c.move == 3.0 );
+
+        // the wide handle is the one a Trait made from a const pointer has
+        Moveable wide = thin.Wide();
+        REQUIRE( wide.Get<Circle>() == nullptr );
+        REQUIRE( wide.Get<const Circle>() == &c );
+        REQUIRE( wide.table == Moveable( const_circle ).table );
+
+        const Thin const_thin = &c;
+        REQUIRE( const_thin.Call<Shape::Area>() == 3.0 );
+    }
+}
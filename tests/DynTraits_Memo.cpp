@@ -0,0 +1,297 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Batch.h"
+#include "Dense.h"
+#include "Memo.h"
+
+namespace memo
+{
+
+// Calls that reached the uncached implementations.
+int computed = 0;
+
+struct Circle
+{
+    double x = 0.0;
+    double r = 1.0;
+};
+
+struct Rectangle
+{
+    double x = 0.0;
+    double width = 1.0;
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Move   : DynTrt::Method<void, void(DynTrt::Self, double x)> {};
+    struct Extent : DynTrt::Method<void, double(DynTrt::ConstSelf)> {};
+    struct Area   : DynTrt::Method<void, double(DynTrt::ConstSelf, int precision)> {};
+    // Reads its cached extent while it runs.
+    struct Grow   : DynTrt::Method<void, void(DynTrt::Self, double scale)> {};
+
+    using CachedExtent = DynTrt::MemoMethod<Shape, Extent>;
+    using CachedArea = DynTrt::MemoMethod<Shape, Area, 1>;
+    using MoveAll = DynTrt::BatchMethod<Shape, Move>;
+    using mutation_observers = DynTrt::Observers<CachedExtent, CachedArea>;
+
+    using Bounded = DynTrt::Trait<Shape, Move, CachedExtent, CachedArea>;
+    using BatchBounded = DynTrt::Trait<Shape, MoveAll, CachedExtent>;
+    using Moveable = DynTrt::Trait<Shape, Move>;
+    using Growable = DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Narrowable>, CachedExtent, Grow>;
+    using DenseBounded = DynTrt::DenseTrait<Shape, Move, CachedExtent>;
+};
+
+template<>
+void Shape::Invoke<Shape::Move>( Circle* self, double x )
+{
+    self->x += x;
+}
+
+template<>
+void Shape::Invoke<Shape::Move>( Rectangle* self, double x )
+{
+    self->x += x;
+}
+
+template<>
+void Shape::Invoke<Shape::Grow>( Circle* self, double scale )
+{
+    const Shape::Growable growable = static_cast<const Circle*>(self);
+    self->r = growable.Call<Shape::CachedExtent>() * scale - self->x;
+    growable.Call<Shape::CachedExtent>();
+}
+
+template<>
+void Shape::Invoke<Shape::Grow>( Rectangle* self, double scale )
+{
+    self->width *= scale;
+}
+
+template<>
+double Shape::Invoke<Shape::Extent>( const Circle* self )
+{
+    computed++;
+    return self->x + self->r;
+}
+
+template<>
+double Shape::Invoke<Shape::Extent>( const Rectangle* self )
+{
+    computed++;
+    return self->x + self->width;
+}
+
+template<>
+double Shape::Invoke<Shape::Area>( const Circle* self, int precision )
+{
+    computed++;
+    return std::round( 3.14159265 * self->r * self->r * precision ) / precision;
+}
+
+template<>
+double Shape::Invoke<Shape::Area>( const Rectangle* self, int precision )
+{
+    computed++;
+    return std::round( self->width * self->width * precision ) / precision;
+}
+
+}
+
+TEST_CASE("Memo Method", "[Memo]")
+{
+    using namespace memo;
+    computed = 0;
+    Shape::CachedExtent::ResetStats();
+
+    std::vector<Circle> circles(2);
+    Rectangle rectangle;
+    Shape::Bounded circle0 = &circles[0];
+    Shape::Bounded circle1 = &circles[1];
+    Shape::Bounded bounded_rectangle = &rectangle;
+
+    // results for objects that lived at these addresses in earlier sections are still cached
+    for ( const Circle& circle : circles )
+        Shape::CachedExtent::Invalidate( &circle );
+    Shape::CachedExtent::Invalidate( &rectangle );
+
+    SECTION("Cached")
+    {
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( bounded_rectangle.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( bounded_rectangle.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( computed == 2 );
+
+        const DynTrt::MemoStats stats = Shape::CachedExtent::Stats();
+        REQUIRE( stats.hits == 2 );
+        REQUIRE( stats.misses == 2 );
+        REQUIRE( stats.HitRate() == 0.5 );
+    }
+
+    SECTION("Invalidated By Mutation")
+    {
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( circle1.Call<Shape::CachedExtent>() == 1.0 );
+
+        circle0.Call<Shape::Move>( 2.0 );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 3.0 );
+        REQUIRE( computed == 3 );
+
+        // other objects keep their results
+        REQUIRE( circle1.Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( computed == 3 );
+    }
+
+    SECTION("Invalidated By Batch Mutation")
+    {
+        std::vector<Shape::BatchBounded> shapes{ &circles[0], &circles[1] };
+        REQUIRE( shapes[0].Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( shapes[1].Call<Shape::CachedExtent>() == 1.0 );
+
+        DynTrt::BatchCall<Shape::MoveAll>( shapes, 1.0 );
+        REQUIRE( shapes[0].Call<Shape::CachedExtent>() == 2.0 );
+        REQUIRE( shapes[1].Call<Shape::CachedExtent>() == 2.0 );
+        REQUIRE( computed == 4 );
+    }
+
+    SECTION("Invalidated Through Any Trait")
+    {
+        // Moveable has no memo method but mutations through it are still seen
+        Shape::Moveable moveable = &circles[0];
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+        moveable.Call<Shape::Move>( 1.0 );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 2.0 );
+
+        // as are mutations through a narrowed trait
+        Shape::Growable growable = &circles[1];
+        DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::Narrowable>, Shape::Grow> narrowed = growable;
+        REQUIRE( growable.Call<Shape::CachedExtent>() == 1.0 );
+        narrowed.Call<Shape::Grow>( 2.0 );
+        REQUIRE( growable.Call<Shape::CachedExtent>() == 2.0 );
+    }
+
+    SECTION("Invalidated By Dense Trait")
+    {
+        Shape::DenseBounded dense = &circles[0];
+        REQUIRE( dense.Call<Shape::CachedExtent>() == 1.0 );
+        dense.Call<Shape::Move>( 1.0 );
+        REQUIRE( dense.Call<Shape::CachedExtent>() == 2.0 );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 2.0 );
+    }
+
+    SECTION("Mutator Reading The Cache")
+    {
+        // Grow caches the extent before changing it, the result must not survive the call
+        Shape::Growable growable = &circles[0];
+        growable.Call<Shape::Grow>( 2.0 );
+        REQUIRE( circles[0].r == 2.0 );
+        REQUIRE( growable.Call<Shape::CachedExtent>() == 2.0 );
+    }
+
+    SECTION("Manual Invalidation")
+    {
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+        Shape::Invoke<Shape::Move>( &circles[0], 1.0 );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 1.0 );
+
+        Shape::CachedExtent::Invalidate( &circles[0] );
+        REQUIRE( circle0.Call<Shape::CachedExtent>() == 2.0 );
+    }
+
+    SECTION("Many Objects")
+    {
+        // mutating more objects than there used to be version counters keeps other results
+        std::vector<Circle> many(101);
+        std::vector<Shape::Bounded> shapes;
+        for ( Circle& circle : many )
+        {
+            Shape::CachedExtent::Invalidate( &circle );
+            shapes.emplace_back( &circle );
+        }
+
+        REQUIRE( shapes[100].Call<Shape::CachedExtent>() == 1.0 );
+        for ( size_t i = 0; i < 100; i++ )
+            shapes[i].Call<Shape::Move>( 1.0 );
+        REQUIRE( shapes[100].Call<Shape::CachedExtent>() == 1.0 );
+        REQUIRE( computed == 1 );
+
+        for ( size_t i = 0; i < 100; i++ )
+            REQUIRE( shapes[i].Call<Shape::CachedExtent>() == 2.0 );
+    }
+
+    SECTION("Arguments And Capacity")
+    {
+        REQUIRE( circle0.Call<Shape::CachedArea>( 100 ) == 3.14 );
+        REQUIRE( circle0.Call<Shape::CachedArea>( 100 ) == 3.14 );
+        REQUIRE( computed == 1 );
+
+        // one slot, so alternating arguments always misses
+        REQUIRE( circle0.Call<Shape::CachedArea>( 1000 ) == 3.142 );
+        REQUIRE( circle0.Call<Shape::CachedArea>( 100 ) == 3.14 );
+        REQUIRE( computed == 3 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Memo]"
+TEST_CASE("Memo Method Benchmark", "[.][Benchmark][Memo]")
+{
+    using namespace memo;
+
+    std::vector<Circle> circles(100);
+    std::vector<Shape::Bounded> shapes;
+    for ( Circle& circle : circles )
+        shapes.emplace_back( &circle );
+
+    BENCHMARK( "Uncached" )
+    {
+        double total = 0.0;
+        for ( int i = 0; i < 10; i++ )
+        {
+            for ( const auto& shape : shapes )
+                total += Shape::Invoke<Shape::Extent>( shape.Get<Circle>() );
+        }
+        return total;
+    };
+
+    BENCHMARK( "Cached" )
+    {
+        double total = 0.0;
+        for ( int i = 0; i < 10; i++ )
+        {
+            for ( const auto& shape : shapes )
+                total += shape.Call<Shape::CachedExtent>();
+        }
+        return total;
+    };
+}
@@ -0,0 +1,113 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "DynTrt.h"
+#include "Multi.h"
+#include "Shapes.h"
+
+namespace multi
+{
+
+using shapes::Circle;
+using shapes::Rectangle;
+using shapes::Triangle;
+
+using Shaped = DynTrt::Trait<shapes::Shape, shapes::Shape::Area>;
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    // Registered one way round, the other comes from the Symmetric fallback.
+    struct Collide : DynTrt::MultiMethod<double(DynTrt::ConstSelf, DynTrt::ConstSelf), DynTrt::Symmetric> {};
+    // Order matters, the first is modified.
+    struct Hit : DynTrt::MultiMethod<void(DynTrt::Self, DynTrt::ConstSelf, double force)> {};
+};
+
+// Sum of the extents, so the result shows which objects were passed and in what order.
+template<> double Shape::Invoke<Shape::Collide>( const Circle* a, const Circle* b ) { return a->r + b->r; }
+template<> double Shape::Invoke<Shape::Collide>( const Circle* a, const Rectangle* b ) { return a->r + 2.0 * b->width; }
+template<> double Shape::Invoke<Shape::Collide>( const Rectangle* a, const Rectangle* b ) { return a->width + 2.0 * b->width; }
+
+template<> void Shape::Invoke<Shape::Hit>( Circle* a, const Rectangle* b, double force ) { a->move += force * b->width; }
+template<> void Shape::Invoke<Shape::Hit>( Rectangle* a, const Circle* b, double force ) { a->move += force * b->r; }
+
+}
+
+TEST_CASE("Multimethods", "[Multi]")
+{
+    using namespace multi;
+
+    DynTrt::RegisterPair<Shape, Shape::Collide, Circle, Circle>();
+    DynTrt::RegisterPair<Shape, Shape::Collide, Circle, Rectangle>();
+    DynTrt::RegisterPair<Shape, Shape::Collide, Rectangle, Rectangle>();
+    DynTrt::RegisterPair<Shape, Shape::Hit, Circle, Rectangle>();
+    DynTrt::RegisterPair<Shape, Shape::Hit, Rectangle, Circle>();
+
+    Circle c;
+    Rectangle r;
+    Triangle t;
+    Shaped circle = &c;
+    Shaped rectangle = &r;
+    Shaped triangle = &t;
+
+    SECTION("Both types")
+    {
+        REQUIRE( DynTrt::MultiCall<Shape::Collide>( circle, circle ) == 2.0 );
+        REQUIRE( DynTrt::MultiCall<Shape::Collide>( circle, rectangle ) == 5.0 );
+        REQUIRE( DynTrt::MultiCall<Shape::Collide>( rectangle, rectangle ) == 6.0 );
+    }
+
+    SECTION("Symmetric fallback")
+    {
+        REQUIRE( DynTrt::MultiCall<Shape::Collide>( rectangle, circle ) == 5.0 );
+    }
+
+    SECTION("Ordered with arguments")
+    {
+        DynTrt::MultiCall<Shape::Hit>( circle, rectangle, 3 );
+        DynTrt::MultiCall<Shape::Hit>( rectangle, circle, 3 );
+        REQUIRE( c.move == 6.0 );
+        REQUIRE( r.move == 3.0 );
+
+        // Hit is not symmetric
+        REQUIRE_THROWS_AS( DynTrt::MultiCall<Shape::Hit>( circle, circle, 1 ), DynTrt::bad_multimethod_call );
+    }
+
+    SECTION("Const handles")
+    {
+        const Circle* const_circle = &c;
+        const Shaped constant = const_circle;
+        REQUIRE( DynTrt::MultiCall<Shape::Collide>( constant, rectangle ) == 5.0 );
+    }
+
+    SECTION("Unregistered")
+    {
+        REQUIRE_THROWS_AS( DynTrt::MultiCall<Shape::Collide>( circle, triangle ), DynTrt::bad_multimethod_call );
+        REQUIRE_THROWS_AS( DynTrt::MultiCall<Shape::Collide>( triangle, triangle ), DynTrt::bad_multimethod_call );
+    }
+}
@@ -0,0 +1,172 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Parallel.h"
+#include "Shapes.h"
+
+namespace parallel
+{
+
+using shapes::Circle;
+using shapes::Rectangle;
+using shapes::Shape;
+
+using Moveable = DynTrt::Trait<Shape, Shape::Move, Shape::Area>;
+
+// Throws from Move, the exception has to reach the caller of ParallelCall.
+struct Failing
+{
+};
+
+}
+
+template<>
+void shapes::Shape::Invoke<shapes::Shape::Move>( parallel::Failing*, double, double )
+{
+    throw std::runtime_error("failing");
+}
+
+template<>
+double shapes::Shape::Invoke<shapes::Shape::Area>( const parallel::Failing* )
+{
+    return 0.0;
+}
+
+TEST_CASE("Parallel Call", "[Parallel]")
+{
+    using namespace parallel;
+
+    constexpr std::size_t count = 20000;
+    std::vector<Circle> circles(count);
+    std::vector<Rectangle> rectangles(count);
+
+    std::vector<Moveable> shapes;
+    for ( std::size_t i = 0; i < count; i++ )
+    {
+        shapes.emplace_back( &circles[i] );
+        if ( i % 3 == 0 )
+            shapes.emplace_back( &rectangles[i] );
+    }
+
+    for ( std::size_t threads : { 1, 4 } )
+    {
+        DynTrt::ThreadPool pool{ threads };
+        REQUIRE( pool.Size() == threads );
+
+        for ( auto& c : circles ) c.move = 0.0;
+        for ( auto& r : rectangles ) r.move = 0.0;
+
+        DynTrt::ParallelCall<Shape::Move>( pool, shapes, 0.5, 1.0 );
+        bool moved = true;
+        for ( std::size_t i = 0; i < count; i++ )
+            moved = moved && circles[i].move == 3.0 && rectangles[i].move == ( i % 3 == 0 ? 1.5 : 0.0 );
+        REQUIRE( moved );
+
+        const double area = DynTrt::ParallelReduce<Shape::Area>( pool, shapes, 0.0, std::plus<>{} );
+        REQUIRE( area == 3.0 * count + 4.0 * ( (count + 2) / 3 ) );
+    }
+
+    SECTION("Default pool")
+    {
+        DynTrt::ParallelCall<Shape::Move>( shapes, 0.5, 1.0 );
+        REQUIRE( circles[0].move == 6.0 );
+    }
+
+    SECTION("Chunks end on runs")
+    {
+        DynTrt::Partition( shapes );
+        const auto ranges = DynTrt::detail::chunk_runs( std::span{shapes}, 4 );
+        REQUIRE( ranges.front().begin == 0 );
+        REQUIRE( ranges.back().end == shapes.size() );
+        for ( std::size_t i = 1; i < ranges.size(); i++ )
+            REQUIRE( ranges[i].begin == ranges[i - 1].end );
+    }
+
+    SECTION("Exceptions")
+    {
+        DynTrt::ThreadPool pool{ 4 };
+        Failing failing;
+        const auto middle = static_cast<std::ptrdiff_t>( shapes.size() / 2 );
+        shapes.emplace( shapes.begin() + middle, &failing );
+        REQUIRE_THROWS_AS( DynTrt::ParallelCall<Shape::Move>( pool, shapes, 0.5, 1.0 ), std::runtime_error );
+
+        // pool still usable
+        shapes.erase( shapes.begin() + middle );
+        DynTrt::ParallelCall<Shape::Move>( pool, shapes, 0.5, 1.0 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Parallel]"
+TEST_CASE("Parallel Call Benchmark", "[.][Benchmark][Parallel]")
+{
+    using namespace parallel;
+
+    static std::mt19937 generator;
+    std::uniform_int_distribution<int> dist{0, 1};
+    std::vector<std::unique_ptr<Circle>> circles;
+    std::vector<std::unique_ptr<Rectangle>> rectangles;
+    std::vector<Moveable> shapes;
+    for ( size_t i = 0; i < 500000; i++ )
+    {
+        if ( dist(generator) )
+        {
+            circles.emplace_back( std::make_unique<Circle>() );
+            shapes.emplace_back( circles.back().get() );
+        }
+        else
+        {
+            rectangles.emplace_back( std::make_unique<Rectangle>() );
+            shapes.emplace_back( rectangles.back().get() );
+        }
+    }
+    DynTrt::Partition( shapes );
+
+    const std::size_t cores = std::max<std::size_t>( std::thread::hardware_concurrency(), 1 );
+    for ( std::size_t threads = 1; threads <= cores; threads *= 2 )
+    {
+        DynTrt::ThreadPool pool{ threads };
+
+        BENCHMARK( "Parallel Call " + std::to_string(threads) + " threads" )
+        {
+            DynTrt::ParallelCall<Shape::Move>( pool, shapes, 0.5, 1.0 );
+            return shapes.size();
+        };
+
+        BENCHMARK( "Parallel Reduce " + std::to_string(threads) + " threads" )
+        {
+            return DynTrt::ParallelReduce<Shape::Area>( pool, shapes, 0.0, std::plus<>{} );
+        };
+    }
+}
@@ -0,0 +1,184 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "DynTrt.h"
+#include "Batch.h"
+#include "Plugin.h"
+#include "plugin/ShapePlugin.h"
+
+namespace plugin
+{
+
+// Only known to the host.
+struct Triangle
+{
+    double base = 1.0;
+    double height = 1.0;
+};
+
+template<>
+double Shape::Invoke<Shape::Area>( const Triangle* self )
+{
+    return 0.5 * self->base * self->height;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Triangle* self, double scale )
+{
+    self->base *= scale;
+    self->height *= scale;
+}
+
+// DYNTRT_TEST_PLUGIN is the path of the plugin built from tests/plugin, set by CMake.
+struct Library
+{
+    Library()
+    {
+#if defined(_WIN32)
+        handle = LoadLibraryA( DYNTRT_TEST_PLUGIN );
+#else
+        handle = dlopen( DYNTRT_TEST_PLUGIN, RTLD_NOW | RTLD_LOCAL );
+#endif
+    }
+
+    ~Library()
+    {
+#if defined(_WIN32)
+        if ( handle )
+            FreeLibrary( static_cast<HMODULE>(handle) );
+#else
+        if ( handle )
+            dlclose( handle );
+#endif
+    }
+
+    template<typename TyFunction>
+    TyFunction Find( const char* name ) const
+    {
+#if defined(_WIN32)
+        return reinterpret_cast<TyFunction>(GetProcAddress( static_cast<HMODULE>(handle), name ));
+#else
+        return reinterpret_cast<TyFunction>(dlsym( handle, name ));
+#endif
+    }
+
+    void* handle = nullptr;
+};
+
+}
+
+TEST_CASE("Plugin Trait", "[Plugin]")
+{
+    using namespace plugin;
+
+    SECTION("In Process")
+    {
+        Triangle triangle{ 2.0, 3.0 };
+        Shapes shape = &triangle;
+        REQUIRE( shape.Call<Shape::Area>() == 3.0 );
+        shape.Call<Shape::Scale>( 2.0 );
+        REQUIRE( triangle.base == 4.0 );
+
+        REQUIRE( shape.Get<Triangle>() == &triangle );
+        REQUIRE( shape.Get<Circle>() == nullptr );
+        REQUIRE( shape.Type() == DynTrt::stable_type_id<Triangle> );
+        REQUIRE( shape.TypeName() == DynTrt::stable_name<Triangle> );
+
+        // one table per type, and Accept takes it back
+        Triangle other;
+        REQUIRE( Shapes{ &other }.Identity() == shape.Identity() );
+        REQUIRE( Shapes::Accept( &Shapes::Export<Triangle>() ) == &Shapes::Export<Triangle>() );
+        REQUIRE( ReversedShapes::Accept( &Shapes::Export<Triangle>() ) == nullptr );
+    }
+
+    SECTION("Stable Names")
+    {
+        STATIC_REQUIRE( DynTrt::stable_type_id<Circle> == DynTrt::stable_type_id<const Circle> );
+        STATIC_REQUIRE( DynTrt::stable_type_id<Circle> != DynTrt::stable_type_id<Square> );
+        STATIC_REQUIRE( Shapes::signature != ReversedShapes::signature );
+    }
+
+    SECTION("Loaded")
+    {
+        Library library;
+        REQUIRE( library.handle );
+
+        const auto circle_table = library.Find<TableFunction>( "dyntrt_circle_table" );
+        const auto square_table = library.Find<TableFunction>( "dyntrt_square_table" );
+        const auto reversed_table = library.Find<TableFunction>( "dyntrt_reversed_circle_table" );
+        const auto create_circle = library.Find<CreateFunction>( "dyntrt_create_circle" );
+        const auto destroy_circle = library.Find<DestroyFunction>( "dyntrt_destroy_circle" );
+        const auto create_square = library.Find<CreateFunction>( "dyntrt_create_square" );
+        const auto destroy_square = library.Find<DestroyFunction>( "dyntrt_destroy_square" );
+        REQUIRE( circle_table );
+        REQUIRE( square_table );
+        REQUIRE( reversed_table );
+        REQUIRE( create_circle );
+        REQUIRE( destroy_circle );
+        REQUIRE( create_square );
+        REQUIRE( destroy_square );
+
+        const Shapes::vtable* circles = Shapes::Accept( circle_table() );
+        const Shapes::vtable* squares = Shapes::Accept( square_table() );
+        REQUIRE( circles );
+        REQUIRE( squares );
+        REQUIRE( Shapes::Accept( reversed_table() ) == nullptr );
+        REQUIRE( ReversedShapes::Accept( reversed_table() ) );
+
+        void* circle_object = create_circle( 2.0 );
+        void* square_object = create_square( 3.0 );
+        {
+            Triangle triangle{ 2.0, 2.0 };
+            std::vector<Shapes> shapes{ Shapes{ *circles, circle_object }, Shapes{ *squares, square_object }, &triangle };
+
+            REQUIRE( shapes[0].Call<Shape::Area>() == 12.0 );
+            REQUIRE( shapes[1].Call<Shape::Area>() == 9.0 );
+            REQUIRE( shapes[2].Call<Shape::Area>() == 2.0 );
+
+            DynTrt::BatchCall<Shape::Scale>( shapes, 2.0 );
+            REQUIRE( shapes[0].Call<Shape::Area>() == 48.0 );
+            REQUIRE( shapes[1].Call<Shape::Area>() == 36.0 );
+            REQUIRE( shapes[2].Call<Shape::Area>() == 8.0 );
+
+            // identity comes from the names, not from addresses in either binary
+            REQUIRE( shapes[0].TypeName() == "plugin.Circle" );
+            REQUIRE( shapes[0].Get<Circle>() == circle_object );
+            REQUIRE( shapes[0].Get<Circle>()->r == 4.0 );
+            REQUIRE( shapes[0].Get<Square>() == nullptr );
+            REQUIRE( shapes[1].Get<Square>() == square_object );
+            REQUIRE( shapes[2].Get<Triangle>() == &triangle );
+        }
+        destroy_circle( circle_object );
+        destroy_square( square_object );
+    }
+}
@@ -3,7 +3,12 @@
 
 #include "VirtualHelper.h"
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include <random>
+#include <span>
+#include <stdexcept>
 #include <variant>
 
 #include "DynTrt.h"
@@ -61,6 +66,52 @@ struct Triangle
     void PrintRotate(double x) { printf("Triangle Rotate: %lf\n", x); }
 };
 
+// Fits inline everywhere.
+struct Dot
+{
+    void PrintDraw() const { printf("Dot Draw\n"); }
+
+    double move = 0.0;
+};
+
+// Too big for the default inline capacity of DynTrt::Any.
+struct Polygon
+{
+    void PrintDraw() const { printf("Polygon Draw\n"); }
+
+    double points[8] = {};
+    double move = 0.0;
+};
+
+// Non trivial, only safe in AnySmall now it runs copy/move/destroy.
+struct Label
+{
+    Label( std::string text, std::shared_ptr<int> owner ): text(std::move(text)), owner(std::move(owner)) {}
+
+    void PrintDraw() const { printf("Label Draw %s\n", text.c_str()); }
+
+    std::string text;
+    std::shared_ptr<int> owner;
+};
+
+struct Unconstructible
+{
+    Unconstructible() { throw std::runtime_error("construction failed"); }
+
+    void PrintDraw() const {}
+};
+
+// Spills from AnyBuffer as it has no nothrow move, and throws when copied.
+struct CopyThrows
+{
+    CopyThrows()=default;
+    CopyThrows( const CopyThrows& ) { throw std::runtime_error("copy failed"); }
+
+    void PrintDraw() const {}
+
+    double data[8]{};
+};
+
 }
 
 #define ANY_INVOKE_DEFINITION() \
@@ -94,7 +145,14 @@ struct Shape
     using Drawable =    DynTrt::AnySmall<16, Shape, Draw>;
 
     using Any = DynTrt::AnySmall<16, Shape, Move, Draw>;
+    using InlineTransform = DynTrt::AnySmall<16, DynTrt::Policy<Shape, DynTrt::InlineLayout>, Move>;
+    using Boxed = DynTrt::Any<Shape, Move, Draw>;
+    using StdBoxed = DynTrt::StdAny<Shape, Move, Draw>;
     using Traits = DynTrt::Trait<Shape, Shape::Move, Shape::Draw>;
+
+    // Values whose views can be narrowed
+    using Narrow = DynTrt::Policy<Shape, DynTrt::Narrowable>;
+    using NarrowAny = DynTrt::AnySmall<16, Narrow, Move, Draw>;
 };
 
 // struct Shape
@@ -161,6 +219,18 @@ void Shape::Invoke<Shape::Rotate>( tst::Rectangle* rectangle, double x )
     rectangle->PrintRotate(x);
 }
 
+template<>
+void Shape::Invoke<Shape::Move>( tst::Polygon* polygon, double x, double y )
+{
+    polygon->move += x + y;
+}
+
+template<>
+void Shape::Invoke<Shape::Move>( tst::Dot* dot, double x, double y )
+{
+    dot->move += x + y;
+}
+
 template<>
 void Shape::Invoke<Shape::Draw>( tst::Triangle* triangle )
 {
@@ -220,6 +290,10 @@ TEST_CASE("Any Traits Basic", "[Any Traits][Basic]")
     shape.Call<Shape::Move>(1.0, 0.69);
     //shape.Call<Shape::Draw>();
 
+    Shape::InlineTransform inline_shape = tst::Circle{};
+    inline_shape.Call<Shape::Move>(1.5, 0.0);
+    REQUIRE( inline_shape.Get<tst::Circle>().move == 1.0 );
+
     if constexpr ( false )
     {
         static std::mt19937 generator;
@@ -325,6 +399,368 @@ TEST_CASE("Any Traits Basic", "[Any Traits][Basic]")
     }
 }
 
+TEST_CASE("Any Small Non Trivial", "[Any Traits][Lifetime]")
+{
+    using Drawable = DynTrt::AnySmall<64, Shape, Shape::Draw>;
+
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    {
+        Drawable label{ std::in_place_type<tst::Label>, "label", owner };
+        REQUIRE( owner.use_count() == 2 );
+        label.Call<Shape::Draw>();
+
+        Drawable copy = label;
+        REQUIRE( owner.use_count() == 3 );
+        REQUIRE( copy.Get<tst::Label>().text == "label" );
+
+        Drawable moved = std::move(copy);
+        REQUIRE( owner.use_count() == 3 );
+        REQUIRE( moved.Get<tst::Label>().text == "label" );
+
+        moved.emplace<tst::Circle>();
+        REQUIRE( owner.use_count() == 2 );
+        REQUIRE_THROWS_AS( moved.Get<tst::Label>(), std::bad_any_cast );
+
+        tst::Label& replaced = moved.emplace<tst::Label>("replaced", owner);
+        REQUIRE( owner.use_count() == 3 );
+        REQUIRE( replaced.text == "replaced" );
+        moved.Call<Shape::Draw>();
+    }
+    REQUIRE( owner.use_count() == 1 );
+}
+
+TEST_CASE("Any Storage Throwing Emplace", "[Any Traits][Lifetime]")
+{
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    {
+        DynTrt::AnyStorage<64> storage{ std::in_place_type<tst::Label>, "label", owner };
+        REQUIRE( owner.use_count() == 2 );
+
+        // the old value is gone and is not destroyed a second time with the storage
+        REQUIRE_THROWS_AS( storage.emplace<tst::Unconstructible>(), std::runtime_error );
+        REQUIRE( owner.use_count() == 1 );
+
+        storage.emplace<tst::Label>( "again", owner );
+        REQUIRE( storage.cast<tst::Label>().text == "again" );
+    }
+    REQUIRE( owner.use_count() == 1 );
+}
+
+TEST_CASE("Any Value Throwing Emplace", "[Any Traits][Lifetime]")
+{
+    std::shared_ptr<int> owner = std::make_shared<int>(0);
+    {
+        using Drawable = DynTrt::AnySmall<64, Shape, Shape::Draw>;
+
+        Drawable label{ std::in_place_type<tst::Label>, "label", owner };
+        REQUIRE_THROWS_AS( label.emplace<tst::Unconstructible>(), std::runtime_error );
+
+        // the old value and its table are both still in place
+        REQUIRE( owner.use_count() == 2 );
+        REQUIRE( label.Get<tst::Label>().text == "label" );
+        label.Call<Shape::Draw>();
+
+        Drawable copy = label;
+        REQUIRE( owner.use_count() == 3 );
+    }
+    REQUIRE( owner.use_count() == 1 );
+
+    {
+        using Drawable = DynTrt::AnyBuffered<16, Shape, Shape::Draw>;
+
+        Drawable label{ std::in_place_type<tst::Label>, "label", owner };
+        REQUIRE_THROWS_AS( label.emplace<tst::Unconstructible>(), std::runtime_error );
+        REQUIRE( label.Get<tst::Label>().text == "label" );
+
+        Drawable throws{ std::in_place_type<tst::CopyThrows> };
+        REQUIRE_THROWS_AS( label = throws, std::runtime_error );
+        REQUIRE( owner.use_count() == 2 );
+        label.Call<Shape::Draw>();
+    }
+    REQUIRE( owner.use_count() == 1 );
+}
+
+// Counts allocations passed through to the default resource.
+struct CountingResource : std::pmr::memory_resource
+{
+    void* do_allocate( size_t bytes, size_t alignment ) override
+    {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate( void* p, size_t bytes, size_t alignment ) override
+    {
+        deallocations++;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal( const std::pmr::memory_resource& other ) const noexcept override { return this == &other; }
+
+    int allocations = 0;
+    int deallocations = 0;
+};
+
+TEST_CASE("Any Buffer", "[Any Traits][Allocator]")
+{
+    CountingResource resource;
+
+    SECTION("Inline")
+    {
+        Shape::Boxed shape{ std::allocator_arg, &resource, tst::Circle{} };
+        shape.Call<Shape::Draw>();
+        REQUIRE( resource.allocations == 0 );
+    }
+
+    SECTION("Spill")
+    {
+        {
+            Shape::Boxed shape{ std::allocator_arg, &resource, tst::Polygon{} };
+            REQUIRE( resource.allocations == 1 );
+
+            shape.Call<Shape::Move>(0.5, 1.0);
+            REQUIRE( shape.Get<tst::Polygon>().move == 1.5 );
+
+            Shape::Boxed copy = shape;
+            REQUIRE( resource.allocations == 2 );
+            REQUIRE( copy.Get<tst::Polygon>().move == 1.5 );
+
+            Shape::Boxed moved = std::move(copy);
+            REQUIRE( resource.allocations == 2 );
+            moved.Call<Shape::Move>(0.5, 1.0);
+            REQUIRE( moved.Get<tst::Polygon>().move == 3.0 );
+            REQUIRE( shape.Get<tst::Polygon>().move == 1.5 );
+        }
+        REQUIRE( resource.deallocations == 2 );
+    }
+
+    SECTION("Arena")
+    {
+        std::pmr::monotonic_buffer_resource arena{ &resource };
+        {
+            std::vector<Shape::Boxed> shapes;
+            for ( size_t i = 0; i < 100; i++ )
+                shapes.emplace_back( std::allocator_arg, &arena, tst::Polygon{} );
+
+            for ( auto& shape : shapes )
+                shape.Call<Shape::Move>(0.5, 1.0);
+        }
+        const int allocations = resource.allocations;
+        REQUIRE( allocations < 100 );
+        arena.release();
+        REQUIRE( resource.deallocations == allocations );
+    }
+
+    SECTION("Moves Without Copying")
+    {
+        static_assert( std::is_nothrow_move_constructible_v<Shape::Boxed> );
+        static_assert( std::is_nothrow_move_assignable_v<Shape::Boxed> );
+        static_assert( std::is_nothrow_move_constructible_v<Shape::Any> );
+
+        // growing the vector moves the spilled values rather than copying them
+        std::vector<Shape::Boxed> shapes;
+        for ( size_t i = 0; i < 1000; i++ )
+            shapes.emplace_back( std::allocator_arg, &resource, tst::Polygon{} );
+        REQUIRE( resource.allocations == 1000 );
+    }
+
+    SECTION("Copy Empty")
+    {
+        DynTrt::AnyBuffer<16> spilled{ std::allocator_arg, &resource, std::in_place_type<tst::Polygon> };
+        DynTrt::AnyBuffer<16> moved = std::move(spilled);
+        DynTrt::AnyBuffer<16> copy = spilled;
+        REQUIRE( resource.allocations == 1 );
+        REQUIRE_THROWS_AS( copy.cast<tst::Polygon>(), std::bad_any_cast );
+
+        copy = moved;
+        REQUIRE( resource.allocations == 2 );
+        copy = spilled;
+        REQUIRE( resource.deallocations == 1 );
+    }
+
+    SECTION("Copy Throws")
+    {
+        {
+            DynTrt::AnyBuffer<16> value{ std::allocator_arg, &resource, std::in_place_type<tst::CopyThrows> };
+            REQUIRE( ! value.is_inline() );
+            REQUIRE_THROWS_AS( DynTrt::AnyBuffer<16>( value ), std::runtime_error );
+
+            DynTrt::AnyBuffer<16> other{ std::allocator_arg, &resource, std::in_place_type<tst::Polygon> };
+            REQUIRE_THROWS_AS( other = value, std::runtime_error );
+            REQUIRE_THROWS_AS( other.cast<tst::CopyThrows>(), std::bad_any_cast );
+        }
+        REQUIRE( resource.allocations == resource.deallocations );
+    }
+
+    SECTION("Emplace Throws")
+    {
+        DynTrt::AnyBuffer<16> value{ std::allocator_arg, &resource, std::in_place_type<tst::Dot> };
+        REQUIRE( value.is_inline() );
+        REQUIRE_THROWS_AS( value.emplace<tst::Unconstructible>(), std::runtime_error );
+        REQUIRE( ! value.is_inline() );
+
+        // the empty buffer moves as empty
+        DynTrt::AnyBuffer<16> moved = std::move(value);
+        REQUIRE_THROWS_AS( moved.cast<tst::Dot>(), std::bad_any_cast );
+
+        DynTrt::AnyBuffer<16> other{ std::allocator_arg, &resource, std::in_place_type<tst::Polygon> };
+        other = std::move(moved);
+        REQUIRE_THROWS_AS( other.cast<tst::Polygon>(), std::bad_any_cast );
+        REQUIRE( resource.allocations == resource.deallocations );
+
+        other.emplace<tst::Dot>();
+        REQUIRE( other.is_inline() );
+    }
+
+    SECTION("std::any")
+    {
+        Shape::StdBoxed shape = tst::Polygon{};
+        shape.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( shape.Get<tst::Polygon>().move == 1.5 );
+        REQUIRE_THROWS_AS( shape.Get<tst::Circle>(), std::bad_any_cast );
+    }
+}
+
+// Takes non-owning handles, fed from owning containers through View.
+static void MoveAll( std::span<Shape::Traits> shapes )
+{
+    for ( auto& shape : shapes )
+        shape.Call<Shape::Move>(0.5, 1.0);
+}
+
+TEST_CASE("Any View", "[Any Traits][View]")
+{
+    Shape::Any circle = tst::Circle{};
+    Shape::Boxed polygon = tst::Polygon{};
+
+    SECTION("Same methods")
+    {
+        Shape::Traits view = circle.View();
+        REQUIRE( view.Get<tst::Circle>() == &circle.Get<tst::Circle>() );
+        REQUIRE( view.Type() == DynTrt::type_id<tst::Circle> );
+
+        view.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( circle.Get<tst::Circle>().move == 1.0 );
+
+        // Spilled values are viewed in place too.
+        Shape::Traits spilled = polygon.View<Shape::Traits>();
+        REQUIRE( spilled.Get<tst::Polygon>() == &polygon.Get<tst::Polygon>() );
+    }
+
+    SECTION("Narrowed")
+    {
+        using Moveable = DynTrt::Trait<Shape::Narrow, Shape::Move>;
+        Shape::NarrowAny narrowable = tst::Circle{};
+        Moveable view = narrowable.View<Moveable>();
+        REQUIRE( view.Get<tst::Circle>() == &narrowable.Get<tst::Circle>() );
+
+        view.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( narrowable.Get<tst::Circle>().move == 1.0 );
+
+        const Shape::NarrowAny& const_narrowable = narrowable;
+        Moveable const_view = const_narrowable.View<Moveable>();
+        REQUIRE( const_view.Get<tst::Circle>() == nullptr );
+        REQUIRE( const_view.Get<const tst::Circle>() == &narrowable.Get<tst::Circle>() );
+
+        // into a trait of the plain Traits struct
+        using PlainMoveable = DynTrt::Trait<Shape, Shape::Move>;
+        PlainMoveable plain = narrowable.View<PlainMoveable>();
+        plain.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( narrowable.Get<tst::Circle>().move == 2.0 );
+        REQUIRE( plain.Identity() == PlainMoveable(&narrowable.Get<tst::Circle>()).Identity() );
+    }
+
+    SECTION("Const")
+    {
+        // a view of a const value has the identity of a const pointer, even once copied
+        const Shape::Any& const_circle = circle;
+        Shape::Traits view = const_circle.View();
+        REQUIRE( view.Type() == DynTrt::type_id<const tst::Circle> );
+        REQUIRE( view.Get<tst::Circle>() == nullptr );
+        REQUIRE( view.Get<const tst::Circle>() == &circle.Get<tst::Circle>() );
+        const tst::Circle* value = &circle.Get<tst::Circle>();
+        REQUIRE( view.table == Shape::Traits( value ).table );
+    }
+
+    SECTION("Inline layout")
+    {
+        Shape::InlineTransform shape = tst::Circle{};
+        auto view = shape.View();
+        view.Call<Shape::Move>(0.5, 1.0);
+        REQUIRE( shape.Get<tst::Circle>().move == 1.0 );
+    }
+
+    SECTION("Owning container")
+    {
+        std::vector<Shape::Any> shapes;
+        shapes.emplace_back( tst::Circle{} );
+        shapes.emplace_back( tst::Rectangle{} );
+
+        std::vector<Shape::Traits> views;
+        for ( auto& shape : shapes )
+            views.push_back( shape.View() );
+
+        MoveAll( views );
+        REQUIRE( shapes[0].Get<tst::Circle>().move == 1.0 );
+        REQUIRE( shapes[1].Get<tst::Rectangle>().move == 1.0 );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Allocator]"
+TEST_CASE("Any Buffer Benchmark", "[.][Benchmark][Allocator]")
+{
+    // Same fragmented heap as the Any Traits Basic benchmarks.
+    static std::mt19937 generator;
+    std::uniform_int_distribution<int> distribution{10, 1000};
+    std::vector<std::unique_ptr<char[]>> fragments;
+    for ( size_t i = 0; i < 10000; i++ )
+    {
+        fragments.emplace_back( new char[distribution(generator)] );
+    }
+
+    std::uniform_int_distribution<int> dist{0, 1};
+    std::vector<int> kinds;
+    for ( size_t i = 0; i < 10000; i++ )
+        kinds.push_back( dist(generator) );
+
+    auto run = [&]( auto& shapes, auto make ) {
+        shapes.reserve( kinds.size() );
+        for ( int kind : kinds )
+        {
+            if ( kind )
+                make( tst::Dot{} );
+            else
+                make( tst::Polygon{} );
+        }
+
+        for ( size_t i = 0; i < 10; i++ )
+        {
+            for ( auto& shape : shapes )
+                shape.template Call<Shape::Move>(0.5, 1.0);
+        }
+        return shapes.size();
+    };
+
+    BENCHMARK( "std::any Vector" )
+    {
+        std::vector<DynTrt::StdAny<Shape, Shape::Move>> shapes;
+        return run( shapes, [&]( auto value ) { shapes.emplace_back( value ); } );
+    };
+
+    BENCHMARK( "AnyBuffer Vector" )
+    {
+        std::vector<DynTrt::Any<Shape, Shape::Move>> shapes;
+        return run( shapes, [&]( auto value ) { shapes.emplace_back( value ); } );
+    };
+
+    BENCHMARK( "AnyBuffer Arena Vector" )
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        std::vector<DynTrt::Any<Shape, Shape::Move>> shapes;
+        return run( shapes, [&]( auto value ) { shapes.emplace_back( std::allocator_arg, &arena, value ); } );
+    };
+}
+
 inline void Drawa( const Shape::Traits shape )
 {
     //.Call<Shape::Draw>();
@@ -0,0 +1,251 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DynTrt.h"
+#include "Any.h"
+#include "Snapshot.h"
+
+namespace snapshot
+{
+
+struct Circle
+{
+    double x = 0.0;
+    double r = 1.0;
+};
+
+struct Rectangle
+{
+    double x = 0.0;
+    float width = 1.0f;
+    float height = 2.0f;
+};
+
+struct Triangle
+{
+    double x = 0.0;
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Move : DynTrt::Method<void, void(DynTrt::Self, double x)> {};
+    struct Size : DynTrt::Method<void, double(DynTrt::ConstSelf)> {};
+    struct Name : DynTrt::Method<void, std::string(DynTrt::ConstSelf)> {};
+
+    using Small = DynTrt::AnySmall<16, Shape, Move, Size>;
+    using InlineSmall = DynTrt::AnySmall<16, DynTrt::Policy<Shape, DynTrt::InlineLayout>, Move, Size>;
+    using Named = DynTrt::AnySmall<16, Shape, Move, Name>;
+};
+
+template<> void Shape::Invoke<Shape::Move>( Circle* self, double x ) { self->x += x; }
+template<> void Shape::Invoke<Shape::Move>( Rectangle* self, double x ) { self->x += x; }
+template<> void Shape::Invoke<Shape::Move>( Triangle* self, double x ) { self->x += x; }
+template<> double Shape::Invoke<Shape::Size>( const Circle* self ) { return self->x + self->r; }
+template<> double Shape::Invoke<Shape::Size>( const Rectangle* self ) { return self->x + self->width * self->height; }
+template<> double Shape::Invoke<Shape::Size>( const Triangle* self ) { return self->x - 1.0; }
+template<> std::string Shape::Invoke<Shape::Name>( const Circle* ) { return "circle"; }
+template<> std::string Shape::Invoke<Shape::Name>( const Rectangle* ) { return "rectangle"; }
+
+// Removes the file at the end of a test.
+struct TemporaryFile
+{
+    explicit TemporaryFile( const char* name ): path((std::filesystem::temp_directory_path() / name).string()) {}
+    ~TemporaryFile() { std::remove( path.c_str() ); }
+
+    const char* c_str() const { return path.c_str(); }
+
+    std::string path;
+};
+
+}
+
+template<> inline constexpr std::string_view DynTrt::stable_name<snapshot::Circle> = "snapshot.Circle";
+template<> inline constexpr std::string_view DynTrt::stable_name<snapshot::Rectangle> = "snapshot.Rectangle";
+
+TEST_CASE("Snapshot", "[Snapshot]")
+{
+    using namespace snapshot;
+    TemporaryFile file{ "dyntrt_snapshot_test.bin" };
+
+    std::vector<Shape::Small> shapes;
+    for ( int i = 0; i < 10000; i++ )
+    {
+        if ( i % 3 )
+            shapes.emplace_back( Circle{ double(i), 1.0 } );
+        else
+            shapes.emplace_back( Rectangle{ double(i), 2.0f, 3.0f } );
+    }
+
+    SECTION("Round Trip")
+    {
+        using Format = DynTrt::Snapshot<Shape::Small, Circle, Rectangle>;
+        Format::Write( file.c_str(), shapes );
+
+        Format::Mapped loaded = Format::Load( file.c_str() );
+        REQUIRE( loaded.Size() == shapes.size() );
+        std::size_t mismatched = 0;
+        for ( std::size_t i = 0; i < shapes.size(); i++ )
+        {
+            if ( loaded.Values()[i].Call<Shape::Size>() != shapes[i].Call<Shape::Size>() )
+                mismatched++;
+        }
+        REQUIRE( mismatched == 0 );
+
+        // values are ordinary AnySmall values again
+        Shape::Small& first = loaded.Values()[0];
+        first.Call<Shape::Move>( 1.0 );
+        REQUIRE( first.Get<Rectangle>().x == 1.0 );
+        REQUIRE_THROWS_AS( first.Get<Circle>(), std::bad_any_cast );
+
+        Shape::Small copy = loaded.Values()[1];
+        REQUIRE( copy.Get<Circle>().x == 1.0 );
+
+        // changes stay in the process
+        Format::Mapped reloaded = Format::Load( file.c_str() );
+        REQUIRE( reloaded.Values()[0].Get<Rectangle>().x == 0.0 );
+    }
+
+    SECTION("Remapped Types")
+    {
+        DynTrt::Snapshot<Shape::Small, Circle, Rectangle>::Write( file.c_str(), shapes );
+
+        // loader registers the types in another order, plus one not in the file
+        using Loader = DynTrt::Snapshot<Shape::Small, Triangle, Rectangle, Circle>;
+        Loader::Mapped loaded = Loader::Load( file.c_str() );
+        REQUIRE( loaded.Values()[0].Get<Rectangle>().width == 2.0f );
+        REQUIRE( loaded.Values()[1].Get<Circle>().r == 1.0 );
+
+        using Missing = DynTrt::Snapshot<Shape::Small, Triangle, Rectangle>;
+        REQUIRE_THROWS_AS( Missing::Load( file.c_str() ), std::runtime_error );
+    }
+
+    SECTION("Inline Layout")
+    {
+        std::vector<Shape::InlineSmall> inline_shapes{ Circle{ 1.0, 2.0 }, Rectangle{ 1.0, 1.0f, 1.0f } };
+        using Format = DynTrt::Snapshot<Shape::InlineSmall, Circle, Rectangle>;
+        Format::Write( file.c_str(), inline_shapes );
+
+        Format::Mapped loaded = Format::Load( file.c_str() );
+        REQUIRE( loaded.Values()[0].Call<Shape::Size>() == 3.0 );
+        REQUIRE( loaded.Values()[1].Call<Shape::Size>() == 2.0 );
+    }
+
+    SECTION("Errors")
+    {
+        std::vector<Shape::Small> unregistered{ Circle{}, Triangle{} };
+        REQUIRE_THROWS_AS( (DynTrt::Snapshot<Shape::Small, Circle, Rectangle>::Write( file.c_str(), unregistered )), std::invalid_argument );
+
+        DynTrt::Snapshot<Shape::Small, Circle, Rectangle>::Write( file.c_str(), shapes );
+        REQUIRE_THROWS_AS( (DynTrt::Snapshot<Shape::Named, Circle, Rectangle>::Load( file.c_str() )), std::runtime_error );
+        REQUIRE_THROWS_AS( (DynTrt::Snapshot<Shape::Small, Circle, Rectangle>::Load( "does/not/exist.bin" )), std::runtime_error );
+    }
+
+    SECTION("Corrupt Header")
+    {
+        using Format = DynTrt::Snapshot<Shape::Small, Circle, Rectangle>;
+        Format::Write( file.c_str(), std::span( shapes.data(), 4 ) );
+
+        std::vector<char> bytes( std::filesystem::file_size( file.path ) );
+        std::FILE* in = std::fopen( file.c_str(), "rb" );
+        REQUIRE( std::fread( bytes.data(), 1, bytes.size(), in ) == bytes.size() );
+        std::fclose( in );
+
+        // Writes bytes with the header changed by edit, cut to size bytes.
+        const auto corrupt = [&]( auto edit, std::size_t size ) {
+            DynTrt::detail::SnapshotHeader header;
+            std::memcpy( &header, bytes.data(), sizeof(header) );
+            edit( header );
+            std::vector<char> changed( bytes.begin(), bytes.begin() + size );
+            std::memcpy( changed.data(), &header, std::min( size, sizeof(header) ) );
+            std::FILE* out = std::fopen( file.c_str(), "wb" );
+            std::fwrite( changed.data(), 1, changed.size(), out );
+            std::fclose( out );
+        };
+
+        corrupt( []( auto& ) {}, bytes.size() );
+        REQUIRE( Format::Load( file.c_str() ).Size() == 4 );
+
+        corrupt( []( auto& header ) { header.count = 50; }, bytes.size() );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+
+        // the values, then the type table too, are past the end
+        corrupt( []( auto& header ) { header.count = 50; }, 100 );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+        corrupt( []( auto& header ) { header.count = 100; }, 80 );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+
+        corrupt( []( auto& header ) { header.type_count = std::uint64_t(1) << 60; }, bytes.size() );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+
+        corrupt( [&]( auto& header ) { header.values_offset = bytes.size() + 64; }, bytes.size() );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+
+        corrupt( []( auto& ) {}, sizeof(DynTrt::detail::SnapshotHeader) - 1 );
+        REQUIRE_THROWS_AS( Format::Load( file.c_str() ), std::runtime_error );
+    }
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Snapshot]"
+TEST_CASE("Snapshot Benchmark", "[.][Benchmark][Snapshot]")
+{
+    using namespace snapshot;
+    using Format = DynTrt::Snapshot<Shape::Small, Circle, Rectangle>;
+    TemporaryFile file{ "dyntrt_snapshot_benchmark.bin" };
+
+    std::mt19937 generator;
+    std::vector<Shape::Small> shapes;
+    for ( int i = 0; i < 1000000; i++ )
+    {
+        if ( generator() % 2 )
+            shapes.emplace_back( Circle{ double(i), 1.0 } );
+        else
+            shapes.emplace_back( Rectangle{ double(i), 2.0f, 3.0f } );
+    }
+    Format::Write( file.c_str(), shapes );
+
+    BENCHMARK( "Load" )
+    {
+        Format::Mapped loaded = Format::Load( file.c_str() );
+        return loaded.Values().back().Call<Shape::Size>();
+    };
+
+    BENCHMARK( "Copy" )
+    {
+        std::vector<Shape::Small> copy = shapes;
+        return copy.back().Call<Shape::Size>();
+    };
+}
@@ -23,6 +23,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "DynTrt.h"
 
 enum class Colour : uint8_t
@@ -83,6 +87,15 @@ struct Shape
     using Drawable =        DynTrt::Trait<Shape, Draw, SetColour>;
     using Transformable =   DynTrt::Trait<Shape, Move, Rotate, Scale>;
     using Moveable =        DynTrt::Trait<Shape, Move, Scale>;
+
+    // Traits that convert to the traits with a subset of their methods
+    using Narrow = DynTrt::Policy<Shape, DynTrt::Narrowable>;
+    using NarrowDrawable =      DynTrt::Trait<Narrow, Draw, SetColour>;
+    using NarrowTransformable = DynTrt::Trait<Narrow, Move, Rotate, Scale>;
+    using NarrowMoveable =      DynTrt::Trait<Narrow, Move, Scale>;
+
+    // Same methods as Drawable with the function pointers stored in the handle
+    using InlineDrawable =  DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::InlineLayout>, Draw, SetColour>;
 };
 
 template<>
@@ -178,6 +191,273 @@ TEST_CASE("DynTrait Basic", "[Basic]")
     }
 }
 
+TEST_CASE("DynTrait Get", "[Basic][Get]")
+{
+    Circle c;
+    Rectangle r;
+
+    Shape::Drawable drawable = &c;
+    REQUIRE( drawable.Get<Circle>() == &c );
+    REQUIRE( drawable.Get<Rectangle>() == nullptr );
+    REQUIRE( drawable.Type() == DynTrt::type_id<Circle> );
+
+    drawable = &r;
+    REQUIRE( drawable.Get<Circle>() == nullptr );
+    REQUIRE( drawable.Get<Rectangle>() == &r );
+
+    // constness is part of the type identity
+    const Circle* const_circle = &c;
+    Shape::Drawable const_drawable = const_circle;
+    REQUIRE( const_drawable.Get<Circle>() == nullptr );
+    REQUIRE( const_drawable.Get<const Circle>() == &c );
+    REQUIRE( std::as_const(const_drawable).Get<Circle>() == &c );
+}
+
+TEST_CASE("DynTrait Narrowing", "[Basic][Narrowing]")
+{
+    static_assert( ! Shape::Transformable::has_projections );
+
+    Rectangle r;
+    Shape::NarrowTransformable transformable = &r;
+
+    Shape::NarrowMoveable moveable = transformable;
+    moveable.Call<Shape::Move>( 0.5, 0.25 );
+    moveable.Call<Shape::Scale>( 2.0 );
+    REQUIRE( r.x == 0.5 );
+    REQUIRE( r.width == 2.0 );
+    REQUIRE( moveable.Get<Rectangle>() == &r );
+
+    // same projection table every time, and the same one a direct construction uses
+    Shape::NarrowMoveable direct = &r;
+    REQUIRE( moveable.table == direct.table );
+    REQUIRE( Shape::NarrowMoveable(transformable).table == moveable.table );
+
+    // narrowing a narrowed handle
+    using Scalable = DynTrt::Trait<Shape::Narrow, Shape::Scale>;
+    Scalable scalable = moveable;
+    scalable.Call<Shape::Scale>( 0.5 );
+    REQUIRE( r.width == 1.0 );
+    REQUIRE( scalable.Get<Rectangle>() == &r );
+
+    // const identity is carried over
+    const Rectangle* const_rectangle = &r;
+    Shape::NarrowTransformable const_transformable = const_rectangle;
+    Shape::NarrowMoveable const_moveable = const_transformable;
+    REQUIRE( const_moveable.Get<Rectangle>() == nullptr );
+    REQUIRE( const_moveable.Get<const Rectangle>() == &r );
+
+    // into the plain aliases, sharing the vtables of handles made from a pointer
+    static_assert( ! Shape::Moveable::has_projections );
+    Shape::Moveable plain = transformable;
+    REQUIRE( plain.table == Shape::Moveable(&r).table );
+    REQUIRE( plain.Identity() == Shape::Moveable(&r).Identity() );
+    plain.Call<Shape::Move>( 1.0, 0.5 );
+    REQUIRE( r.x == 1.0 );
+
+    Shape::Transformable same_methods = transformable;
+    REQUIRE( same_methods.table == Shape::Transformable(&r).table );
+
+    Shape::Moveable const_plain = const_transformable;
+    REQUIRE( const_plain.Type() == DynTrt::type_id<const Rectangle> );
+    REQUIRE( const_plain.table == Shape::Moveable(const_rectangle).table );
+}
+
+TEST_CASE("DynTrait Compose", "[Basic][Compose]")
+{
+    using Entity = DynTrt::Compose<Shape::NarrowDrawable, Shape::NarrowMoveable>;
+    static_assert( std::same_as<Entity, DynTrt::Trait<Shape::Narrow, Shape::Draw, Shape::SetColour, Shape::Move, Shape::Scale>> );
+    static_assert( sizeof(Entity) == sizeof(Shape::NarrowDrawable) );
+
+    // shared methods appear once
+    using Everything = DynTrt::Compose<Shape::Drawable, Shape::Transformable, Shape::Moveable>;
+    static_assert( std::same_as<Everything, DynTrt::Trait<Shape, Shape::Draw, Shape::SetColour, Shape::Move, Shape::Rotate, Shape::Scale>> );
+
+    Circle c;
+    Entity entity = &c;
+    entity.Call<Shape::SetColour>( Colour::blue );
+    entity.Call<Shape::Move>( 0.5, 0.25 );
+    REQUIRE( entity.Call<Shape::Draw>() == Colour::blue );
+    REQUIRE( c.x == 0.5 );
+
+    // components come from the merged vtable's projections
+    Shape::NarrowDrawable drawable = entity;
+    Shape::NarrowMoveable moveable = entity;
+    REQUIRE( drawable.table == Shape::NarrowDrawable(&c).table );
+    REQUIRE( moveable.table == Shape::NarrowMoveable(&c).table );
+
+    moveable.Call<Shape::Scale>( 2.0 );
+    REQUIRE( c.r == 2.0 );
+    REQUIRE( drawable.Get<Circle>() == &c );
+}
+
+TEST_CASE("DynTrait Inline Layout", "[Basic][Inline]")
+{
+    // the function pointers, the static vtable they came from and the object
+    static_assert( sizeof(Shape::InlineDrawable) == sizeof(void*) * 4 );
+    static_assert( sizeof(DynTrt::Trait<DynTrt::Policy<Shape, DynTrt::InlineLayout>, Shape::Draw>) == sizeof(void*) * 3 );
+
+    Circle c;
+    Rectangle r;
+
+    Shape::InlineDrawable drawable = &c;
+    drawable.Call<Shape::SetColour>(Colour::blue);
+    REQUIRE( c.colour == Colour::blue );
+    REQUIRE( drawable.Call<Shape::Draw>() == Colour::blue );
+    REQUIRE( drawable.Get<Circle>() == &c );
+    REQUIRE( drawable.Get<Rectangle>() == nullptr );
+
+    drawable = &r;
+    drawable.Call<Shape::SetColour>(Colour::green);
+    REQUIRE( r.colour == Colour::green );
+    REQUIRE( drawable.Get<Rectangle>() == &r );
+    REQUIRE( drawable.Identity() == Shape::InlineDrawable(&r).Identity() );
+    REQUIRE( drawable.Identity() != Shape::InlineDrawable(&c).Identity() );
+
+    const Rectangle* const_rectangle = &r;
+    Shape::InlineDrawable const_drawable = const_rectangle;
+    REQUIRE( const_drawable.Type() == DynTrt::type_id<const Rectangle> );
+}
+
+// Vtables are constant initialised, so handles to objects with static storage can be
+// made before main and even at compile time.
+constinit Circle static_circle{};
+constinit Shape::Drawable static_drawable = &static_circle;
+constinit Shape::InlineDrawable static_inline_drawable = &static_circle;
+
+constexpr bool SameType()
+{
+    Shape::Drawable a = &static_circle;
+    Shape::Drawable b = &static_circle;
+    return a.Identity() == b.Identity() && a.Type() == DynTrt::type_id<Circle>;
+}
+
+TEST_CASE("DynTrait Constant Initialisation", "[Basic][Constinit]")
+{
+    static_assert( SameType() );
+
+    static_drawable.Call<Shape::SetColour>(Colour::green);
+    REQUIRE( static_circle.colour == Colour::green );
+    REQUIRE( static_inline_drawable.Call<Shape::Draw>() == Colour::green );
+    REQUIRE( static_drawable.Get<Circle>() == &static_circle );
+    REQUIRE( static_drawable.table == Shape::Drawable(&static_circle).table );
+}
+
+// Hidden by default, run with: DynTrtTests "[Benchmark][Inline]"
+TEST_CASE("DynTrait Layout Benchmark", "[.][Benchmark][Inline]")
+{
+    std::vector<Circle> circles(5000);
+    std::vector<Rectangle> rectangles(5000);
+
+    std::vector<Shape::Drawable> table_shapes;
+    std::vector<Shape::InlineDrawable> inline_shapes;
+    for ( size_t i = 0; i < circles.size(); i++ )
+    {
+        table_shapes.emplace_back( &circles[i] );
+        table_shapes.emplace_back( &rectangles[i] );
+        inline_shapes.emplace_back( &circles[i] );
+        inline_shapes.emplace_back( &rectangles[i] );
+    }
+
+    BENCHMARK( "Table Layout" )
+    {
+        int count = 0;
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( const auto& shape : table_shapes )
+                count += shape.Call<Shape::Draw>() == Colour::red;
+        }
+        return count;
+    };
+
+    BENCHMARK( "Inline Layout" )
+    {
+        int count = 0;
+        for ( size_t i = 0; i < 100; i++ )
+        {
+            for ( const auto& shape : inline_shapes )
+                count += shape.Call<Shape::Draw>() == Colour::red;
+        }
+        return count;
+    };
+}
+
+// Not default constructible, counts copies so we can check arguments are forwarded.
+struct Tracked
+{
+    explicit Tracked( int value ): value(value) {}
+    Tracked( const Tracked& other ): value(other.value) { copies++; }
+    Tracked( Tracked&& other )=default;
+
+    int value;
+    static inline int copies = 0;
+};
+
+struct Named
+{
+    std::string name;
+    std::unique_ptr<int> data;
+};
+
+struct Label
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct SetName  : DynTrt::Method<void, void(DynTrt::Self, const std::string& name)> {};
+    struct TakeName : DynTrt::Method<void, void(DynTrt::Self, std::string&& name)> {};
+    struct Attach   : DynTrt::Method<void, void(DynTrt::Self, std::unique_ptr<int> data)> {};
+    struct Track    : DynTrt::Method<Track, int(DynTrt::ConstSelf, Tracked tracked)> {
+        template<typename T>
+        static int Invoke( const T*, Tracked tracked ) { return tracked.value; }
+    };
+
+    using Labelled = DynTrt::Trait<Label, SetName, TakeName, Attach, Track>;
+};
+
+template<>
+void Label::Invoke<Label::SetName>( Named* self, const std::string& name )
+{
+    self->name = name;
+}
+
+template<>
+void Label::Invoke<Label::TakeName>( Named* self, std::string&& name )
+{
+    self->name = std::move(name);
+}
+
+template<>
+void Label::Invoke<Label::Attach>( Named* self, std::unique_ptr<int> data )
+{
+    self->data = std::move(data);
+}
+
+TEST_CASE("DynTrait Forwarding", "[Basic][Forwarding]")
+{
+    Named named;
+    Label::Labelled labelled = &named;
+
+    const std::string name = "circle";
+    labelled.Call<Label::SetName>(name);
+    REQUIRE( named.name == "circle" );
+
+    std::string moved = "a name long enough to live on the heap";
+    labelled.Call<Label::TakeName>(std::move(moved));
+    REQUIRE( named.name == "a name long enough to live on the heap" );
+    REQUIRE( moved.empty() );
+
+    labelled.Call<Label::Attach>(std::make_unique<int>(5));
+    REQUIRE( *named.data == 5 );
+
+    Tracked::copies = 0;
+    REQUIRE( labelled.Call<Label::Track>(Tracked{3}) == 3 );
+    REQUIRE( Tracked::copies == 0 );
+
+    Tracked tracked{4};
+    REQUIRE( labelled.Call<Label::Track>(tracked) == 4 );
+    REQUIRE( Tracked::copies == 1 );
+}
+
 struct Operations
 {
     template<typename T> static Colour Draw(T* self) { return self->colour; }
@@ -0,0 +1,96 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include "DynTrt.h"
+
+// Shapes shared by the tests of the extension headers. Area is computed from the object and
+// circles move twice as far as rectangles, so a test can tell which object a call reached.
+namespace shapes
+{
+
+struct Circle
+{
+    double r = 1.0;
+    double move = 0.0;
+};
+
+struct Rectangle
+{
+    double width = 2.0;
+    double move = 0.0;
+};
+
+struct Triangle
+{
+    double base = 1.0;
+    double height = 1.0;
+    double move = 0.0;
+};
+
+struct Shape
+{
+    template<typename Method, typename T, typename... Ts>
+    static inline Method::return_type Invoke( T*, Ts... );
+
+    struct Move : DynTrt::Method<void, void(DynTrt::Self, double x, double y)> {};
+    struct Area : DynTrt::Method<void, double(DynTrt::ConstSelf)> {};
+};
+
+template<>
+inline void Shape::Invoke<Shape::Move>( Circle* self, double x, double y )
+{
+    self->move += 2.0 * (x + y);
+}
+
+template<>
+inline void Shape::Invoke<Shape::Move>( Rectangle* self, double x, double y )
+{
+    self->move += x + y;
+}
+
+template<>
+inline void Shape::Invoke<Shape::Move>( Triangle* self, double x, double y )
+{
+    self->move += 0.5 * (x + y);
+}
+
+template<>
+inline double Shape::Invoke<Shape::Area>( const Circle* self )
+{
+    return 3.0 * self->r * self->r;
+}
+
+template<>
+inline double Shape::Invoke<Shape::Area>( const Rectangle* self )
+{
+    return self->width * self->width;
+}
+
+template<>
+inline double Shape::Invoke<Shape::Area>( const Triangle* self )
+{
+    return 0.5 * self->base * self->height;
+}
+
+}
@@ -0,0 +1,63 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Test plugin, built as its own shared object with hidden visibility and loaded by DynTraits_Plugin.cpp.
+
+#include "ShapePlugin.h"
+
+namespace plugin
+{
+
+template<>
+double Shape::Invoke<Shape::Area>( const Circle* self )
+{
+    return 3.0 * self->r * self->r;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Circle* self, double scale )
+{
+    self->r *= scale;
+}
+
+template<>
+double Shape::Invoke<Shape::Area>( const Square* self )
+{
+    return self->side * self->side;
+}
+
+template<>
+void Shape::Invoke<Shape::Scale>( Square* self, double scale )
+{
+    self->side *= scale;
+}
+
+}
+
+DYNTRT_PLUGIN_EXPORT const void* dyntrt_circle_table() { return &plugin::Shapes::Export<plugin::Circle>(); }
+DYNTRT_PLUGIN_EXPORT const void* dyntrt_square_table() { return &plugin::Shapes::Export<plugin::Square>(); }
+DYNTRT_PLUGIN_EXPORT const void* dyntrt_reversed_circle_table() { return &plugin::ReversedShapes::Export<plugin::Circle>(); }
+
+DYNTRT_PLUGIN_EXPORT void* dyntrt_create_circle( double r ) { return new plugin::Circle{ r }; }
+DYNTRT_PLUGIN_EXPORT void dyntrt_destroy_circle( void* circle ) { delete static_cast<plugin::Circle*>(circle); }
+DYNTRT_PLUGIN_EXPORT void* dyntrt_create_square( double side ) { return new plugin::Square{ side }; }
+DYNTRT_PLUGIN_EXPORT void dyntrt_destroy_square( void* square ) { delete static_cast<plugin::Square*>(square); }
@@ -0,0 +1,64 @@
+// MIT License
+
+// Copyright (c) 2025 Joshua Nelson
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Shared between the test plugin (a separately built shared object) and the host test.
+
+#pragma once
+#include <string_view>
+#include "DynTrt.h"
+#include "Plugin.h"
+
+namespace plugin
+{
+    struct Circle
+    {
+        double r = 1.0;
+    };
+
+    struct Square
+    {
+        double side = 1.0;
+    };
+
+    struct Shape
+    {
+        template<typename Method, typename T, typename... Ts>
+        static inline Method::return_type Invoke( T*, Ts... );
+
+        struct Area  : DynTrt::Method<void, double(DynTrt::ConstSelf)> {};
+        struct Scale : DynTrt::Method<void, void(DynTrt::Self, double scale)> {};
+
+        using Scalable = DynTrt::Trait<Shape, Area, Scale>;
+        using Reversed = DynTrt::Trait<Shape, Scale, Area>;
+    };
+
+    using Shapes = DynTrt::PluginTrait<Shape::Scalable>;
+    using ReversedShapes = DynTrt::PluginTrait<Shape::Reversed>;
+
+    // Functions exported by the plugin, looked up by name.
+    using TableFunction = const void* (*)();
+    using CreateFunction = void* (*)( double size );
+    using DestroyFunction = void (*)( void* object );
+}
+
+template<> inline constexpr std::string_view DynTrt::stable_name<plugin::Circle> = "plugin.Circle";
+template<> inline constexpr std::string_view DynTrt::stable_name<plugin::Square> = "plugin.Square";